@@ -0,0 +1,50 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/Data/SessionPool.h"
+#include "Poco/Logger.h"
+#include "Poco/Util/Application.h"
+#include "framework/StorageClass.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenWifi::Benchmark {
+
+	//	What follows the benchmark name on the command line: name=value pairs, and files.
+	struct Arguments {
+		std::map<std::string, std::string> Values;
+		std::vector<std::string> Files;
+
+		uint64_t GetInt(const std::string &Name, uint64_t Default) const;
+		std::string Get(const std::string &Name, const std::string &Default = "") const;
+	};
+
+	//	The database given as db=sqlite:<file> or db=postgresql:<connection string>. Benchmarks
+	//	create and empty tables of their own in it: never point it at the service's database.
+	struct Database {
+		DBType Type = sqlite;
+		std::string ConnectionString;
+		std::unique_ptr<Poco::Data::SessionPool> Pool;
+	};
+
+	bool OpenDatabase(const Arguments &Args, Database &DB, Poco::Logger &L);
+
+	inline uint64_t ElapsedNs(std::chrono::steady_clock::time_point Start) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				   std::chrono::steady_clock::now() - Start)
+			.count();
+	}
+
+	//	Each returns the exit code of the tool.
+	int Ingest(const Arguments &Args, Poco::Logger &L);
+	int Codec(const Arguments &Args, Poco::Logger &L);
+	int Parse(const Arguments &Args, Poco::Logger &L);
+	int Mailbox(const Arguments &Args, Poco::Logger &L);
+
+} // namespace OpenWifi::Benchmark
@@ -0,0 +1,44 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Benchmark.h"
+#include "fmt/format.h"
+#include "storage/TimePointCodec.h"
+#include "storage/storage_timepoints.h"
+#include <iostream>
+
+namespace OpenWifi::Benchmark {
+
+	//	Encodes and decodes the latest stored time points with every encoding, so that sizes and
+	//	speeds are those of real devices. Points that do not survive the round trip fail the run.
+	int Codec(const Arguments &Args, Poco::Logger &L) {
+		Database DB;
+		if (!OpenDatabase(Args, DB, L))
+			return Poco::Util::Application::EXIT_USAGE;
+
+		TimePointDB TimePoints(DB.Type, *DB.Pool, L);
+		TimePoints.Create();
+		TimePointDB::RecordVec Records;
+		TimePoints.GetRecords(0, Args.GetInt("points", 10000), Records, "",
+							  " order by timestamp desc ");
+		if (Records.empty()) {
+			std::cout << "There are no time points to encode.\n";
+			return Poco::Util::Application::EXIT_DATAERR;
+		}
+
+		std::vector<TimePointCodec::BenchmarkResult> Results;
+		TimePointCodec::Benchmark(Records, Results);
+		uint64_t Mismatches = 0;
+		for (const auto &R : Results) {
+			std::cout << fmt::format("{:<8} {:>8} points {:>8} bytes/point encode {:>8} ns/point "
+									 "decode {:>8} ns/point {:>6} mismatches\n",
+									 R.encoding, R.points, R.bytes / R.points,
+									 R.encodeNs / R.points, R.decodeNs / R.points, R.mismatches);
+			Mismatches += R.mismatches;
+		}
+		return Mismatches ? Poco::Util::Application::EXIT_SOFTWARE
+						  : Poco::Util::Application::EXIT_OK;
+	}
+
+} // namespace OpenWifi::Benchmark
@@ -0,0 +1,73 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Benchmark.h"
+#include "fmt/format.h"
+#include "storage/PostgresCopy.h"
+#include "storage/storage_wificlients.h"
+#include <iostream>
+
+namespace OpenWifi::Benchmark {
+
+	//	Writes the same synthetic client history rows with each ingest mode, so that their
+	//	throughput can be compared on a given database.
+	int Ingest(const Arguments &Args, Poco::Logger &L) {
+		Database DB;
+		if (!OpenDatabase(Args, DB, L))
+			return Poco::Util::Application::EXIT_USAGE;
+		auto Rows = Args.GetInt("rows", 100000);
+
+		WifiClientHistoryDB Bench(DB.Type, *DB.Pool, L, "wfhbenchmark");
+		Bench.Create();
+		Bench.SetBatchRows(Args.GetInt("batch", 500));
+		Bench.DeleteRecords(" timestamp>=0 ");
+
+		WifiClientHistoryDB::RecordVec Records(Rows);
+		for (uint64_t i = 0; i < Rows; ++i) {
+			auto &R = Records[i];
+			R.station_id = MACAddress(0x020000000000ULL + i);
+			R.bssid = MACAddress(0x020000100000ULL + i % 64);
+			R.ssid = SSIDName("benchmark");
+			R.venue_id = "benchmark";
+			R.rssi = -60;
+			R.rx_bytes = i * 1000;
+			R.tx_bytes = i * 2000;
+			R.mode = "ax";
+		}
+
+		bool Failed = false;
+		auto Run = [&](const char *Mode, auto &&Write) {
+			auto Start = std::chrono::steady_clock::now();
+			bool Done = Write();
+			auto Ns = ElapsedNs(Start);
+			Bench.DeleteRecords(" timestamp>=0 ");
+			if (!Done) {
+				Failed = true;
+				std::cout << fmt::format("{:<10} failed\n", Mode);
+				return;
+			}
+			std::cout << fmt::format("{:<10} {:>10} rows {:>8} ms {:>10} rows/s\n", Mode, Rows,
+									 Ns / 1000000, Ns ? Rows * 1000000000 / Ns : 0);
+		};
+
+		Run("single", [&] {
+			for (const auto &R : Records)
+				if (!Bench.CreateRecord(R))
+					return false;
+			return true;
+		});
+		Run("multirow", [&] { return Bench.CreateRecords(Records); });
+		if (DB.Type == pgsql) {
+			Run("copy", [&] {
+				WifiClientHistoryDB::RecordList Tuples(Records.size());
+				for (std::size_t i = 0; i < Records.size(); ++i)
+					Bench.Convert(Records[i], Tuples[i]);
+				PostgresCopy Copy(DB.ConnectionString, L);
+				return Copy.Copy(Bench.TableName(), Bench.SelectFields(), Tuples);
+			});
+		}
+		return Failed ? Poco::Util::Application::EXIT_SOFTWARE : Poco::Util::Application::EXIT_OK;
+	}
+
+} // namespace OpenWifi::Benchmark
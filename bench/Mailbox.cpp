@@ -0,0 +1,103 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Benchmark.h"
+#include "BoundedQueue.h"
+#include "Mailbox.h"
+#include "VenueWatcher.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace OpenWifi::Benchmark {
+
+	namespace {
+		struct Message {
+			uint64_t Posted = 0;
+			VenueMessage Msg;
+		};
+
+		inline uint64_t Now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					   std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+		}
+
+		//	Three producers, like the state, health and connection receivers, post to one
+		//	consumer, which polls like a board drain on the executor. Returns the latencies.
+		template <typename PushFn, typename PopFn>
+		std::vector<uint64_t> Run(uint64_t Messages, uint64_t Rate, PushFn &&Push, PopFn &&Pop) {
+			const uint64_t Producers = 3;
+			std::vector<uint64_t> Latencies;
+			Latencies.reserve(Messages * Producers);
+
+			std::vector<std::thread> Threads;
+			for (uint64_t p = 0; p < Producers; ++p) {
+				Threads.emplace_back([&, p] {
+					auto Type = static_cast<VenueMessage::MsgType>(p);
+					auto Next = std::chrono::steady_clock::now();
+					for (uint64_t i = 0; i < Messages; ++i) {
+						if (Rate) {
+							Next += std::chrono::nanoseconds(1000000000 / Rate);
+							std::this_thread::sleep_until(Next);
+						}
+						Push(Message{Now(), VenueMessage(i, Type)});
+					}
+				});
+			}
+
+			Message M;
+			while (Latencies.size() < Messages * Producers) {
+				if (Pop(M))
+					Latencies.push_back(Now() - M.Posted);
+				else
+					std::this_thread::yield();
+			}
+			for (auto &T : Threads)
+				T.join();
+			return Latencies;
+		}
+
+		void Report(const char *Name, std::vector<uint64_t> &Latencies, uint64_t Ns) {
+			std::sort(Latencies.begin(), Latencies.end());
+			uint64_t Total = 0;
+			for (auto L : Latencies)
+				Total += L;
+			auto Count = Latencies.size();
+			std::cout << fmt::format("{:<12} {:>9} messages {:>10} msg/s latency mean {:>8} ns "
+									 "p99 {:>9} ns max {:>10} ns\n",
+									 Name, Count, Ns ? Count * 1000000000 / Ns : 0, Total / Count,
+									 Latencies[Count * 99 / 100], Latencies.back());
+		}
+	} // namespace
+
+	//	Post to consume latency of the board mailbox, with the mutex based BoundedQueue it
+	//	replaced as the reference. Both use the block policy and the same capacity.
+	int Mailbox(const Arguments &Args, [[maybe_unused]] Poco::Logger &L) {
+		auto Messages = std::max<uint64_t>(Args.GetInt("messages", 100000), 1);
+		auto Capacity = Args.GetInt("capacity", 1000);
+		auto Rate = Args.GetInt("rate", 0);
+
+		OpenWifi::Mailbox<Message> Box(Capacity, OverloadPolicy::block);
+		auto Start = std::chrono::steady_clock::now();
+		auto Latencies = Run(
+			Messages, Rate, [&Box](Message &&M) { Box.Push(std::move(M)); },
+			[&Box](Message &M) { return Box.TryPop(M); });
+		Report("mailbox", Latencies, ElapsedNs(Start));
+
+		BoundedQueue<Message> Queue(Capacity, OverloadPolicy::block);
+		Start = std::chrono::steady_clock::now();
+		Latencies = Run(
+			Messages, Rate,
+			[&Queue](Message &&M) {
+				auto Key = M.Msg.SerialNumber();
+				Queue.Push(Key, std::move(M));
+			},
+			[&Queue](Message &M) { return Queue.TryPop(M); });
+		Report("boundedqueue", Latencies, ElapsedNs(Start));
+		return Poco::Util::Application::EXIT_OK;
+	}
+
+} // namespace OpenWifi::Benchmark
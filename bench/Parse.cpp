@@ -0,0 +1,109 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Benchmark.h"
+#include "StateDom.h"
+#include "StateParser.h"
+#include "fmt/format.h"
+#include "nlohmann/json.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace OpenWifi::Benchmark {
+
+	//	What the time point and the client history rows are built from, compared field by field
+	//	where it is cheap and by count elsewhere.
+	static bool SameReport(const StateReport &A, const StateReport &B) {
+		auto SameSSIDs = [&] {
+			for (std::size_t i = 0; i < A.DTP.ssid_data.size(); ++i) {
+				const auto &a = A.DTP.ssid_data[i], &b = B.DTP.ssid_data[i];
+				if (a.bssid != b.bssid || a.ssid.Id() != b.ssid.Id() || a.band != b.band ||
+					a.channel != b.channel || a.associations.size() != b.associations.size())
+					return false;
+				for (std::size_t j = 0; j < a.associations.size(); ++j)
+					if (a.associations[j].station != b.associations[j].station ||
+						a.associations[j].tx_bytes != b.associations[j].tx_bytes ||
+						a.associations[j].fingerprint.json != b.associations[j].fingerprint.json ||
+						a.associations[j].tidstats.size() != b.associations[j].tidstats.size())
+						return false;
+			}
+			return true;
+		};
+		return A.serialNumber == B.serialNumber && A.localtime == B.localtime &&
+			   A.uptime == B.uptime && A.associations_2g == B.associations_2g &&
+			   A.associations_5g == B.associations_5g && A.associations_6g == B.associations_6g &&
+			   A.DTP.ap_data.tx_bytes == B.DTP.ap_data.tx_bytes &&
+			   A.DTP.ap_data.rx_bytes == B.DTP.ap_data.rx_bytes &&
+			   A.DTP.radio_data.size() == B.DTP.radio_data.size() &&
+			   A.DTP.ssid_data.size() == B.DTP.ssid_data.size() &&
+			   A.clients.size() == B.clients.size() && SameSSIDs();
+	}
+
+	//	Times ParseState() against the DOM path it replaced, on the same state messages, and checks
+	//	that both extract the same report.
+	int Parse(const Arguments &Args, Poco::Logger &L) {
+		if (Args.Files.empty()) {
+			poco_error(L, "parse needs state message files, such as stats_sample/last_stats.json.");
+			return Poco::Util::Application::EXIT_USAGE;
+		}
+		auto Iterations = std::max<uint64_t>(Args.GetInt("iterations", 200), 1);
+
+		for (const auto &File : Args.Files) {
+			std::ifstream In(File);
+			if (!In) {
+				poco_error(L, "Cannot read " + File);
+				return Poco::Util::Application::EXIT_NOINPUT;
+			}
+			std::stringstream Content;
+			Content << In.rdbuf();
+			//	Bare states, like the samples, get the envelope of a Kafka state message.
+			auto Message = Content.str();
+			auto Doc = nlohmann::json::parse(Message, nullptr, false);
+			if (Doc.is_discarded()) {
+				poco_error(L, File + " is not JSON.");
+				return Poco::Util::Application::EXIT_DATAERR;
+			}
+			if (!Doc.contains("payload"))
+				Message = R"({"payload":{"serial":"24f5a207a130","state":)" + Message + "}}";
+
+			StateReport Dom;
+			auto Start = std::chrono::steady_clock::now();
+			for (uint64_t i = 0; i < Iterations; ++i) {
+				Dom = StateReport{};
+				if (!ParseStateDom(Message, Dom)) {
+					poco_error(L, "The DOM path failed on " + File);
+					return Poco::Util::Application::EXIT_DATAERR;
+				}
+			}
+			auto DomNs = ElapsedNs(Start) / Iterations;
+
+			StateReport Report;
+			ParseCounters Counters;
+			Start = std::chrono::steady_clock::now();
+			for (uint64_t i = 0; i < Iterations; ++i) {
+				Report = StateReport{};
+				if (!ParseState(Message, Report, &Counters)) {
+					poco_error(L, "ParseState failed on " + File);
+					return Poco::Util::Application::EXIT_DATAERR;
+				}
+			}
+			auto SaxNs = ElapsedNs(Start) / Iterations;
+
+			if (!SameReport(Dom, Report)) {
+				poco_error(L, "ParseState and the DOM path disagree on " + File);
+				return Poco::Util::Application::EXIT_DATAERR;
+			}
+
+			std::cout << fmt::format(
+				"{}: {} bytes, dom {} us, ParseState {} us ({:.1f}x), {} clients, "
+				"arena {} bytes in {} allocations, {} overflows\n",
+				File, Message.size(), DomNs / 1000, SaxNs / 1000,
+				SaxNs ? (double)DomNs / (double)SaxNs : 0.0, Report.clients.size(),
+				Counters.arena_bytes, Counters.arena_allocations, Counters.arena_overflows);
+		}
+		return Poco::Util::Application::EXIT_OK;
+	}
+
+} // namespace OpenWifi::Benchmark
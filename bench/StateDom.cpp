@@ -0,0 +1,374 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "StateDom.h"
+#include "Poco/StringTokenizer.h"
+#include "fmt/format.h"
+#include "nlohmann/json.hpp"
+#include <map>
+#include <memory>
+
+namespace OpenWifi::Benchmark {
+
+	namespace {
+		struct InterfaceClientEntry {
+			std::vector<std::string> ipv4_addresses;
+			std::vector<std::string> ipv6_addresses;
+		};
+		using InterfaceClientEntryMap_t = std::map<std::string, InterfaceClientEntry>;
+
+		std::string mac_filter(const std::string &m) {
+			std::string r;
+			for (const auto &c : m)
+				if (c != ':' && c != '-')
+					r += c;
+			return r;
+		}
+
+		template <typename T>
+		void GetJSON(const char *field, const nlohmann::json &doc, T &v, const T &def) {
+			if (doc.contains(field) && !doc[field].is_null()) {
+				v = doc[field].get<T>();
+				return;
+			}
+			v = def;
+		}
+
+		template <typename T>
+		void GetJSON(const char *field1, const char *field2, const nlohmann::json &doc, T &v,
+					 const T &def) {
+			if (doc.contains(field1) && !doc[field1].is_null()) {
+				auto subDoc = doc[field1];
+				if (subDoc.contains(field2) && !subDoc[field2].is_null()) {
+					v = subDoc[field2].get<T>();
+					return;
+				}
+			}
+			v = def;
+		}
+
+		int BandToInt(const std::string &band) {
+			if (band == "2G")
+				return 2;
+			if (band == "5G")
+				return 5;
+			if (band == "6G")
+				return 6;
+			return 2;
+		}
+
+		//	AP::UpdateStats up to the deltas, which ParseState() leaves to AP as well. MACs and
+		//	SSIDs go through the types the time points now use.
+		void UpdateStats(const std::shared_ptr<nlohmann::json> &State, StateReport &R) {
+			auto &DTP = R.DTP;
+
+			if (State->contains("unit")) {
+				auto unit = (*State)["unit"];
+				R.has_unit = true;
+				GetJSON("localtime", unit, R.localtime, (uint64_t)0);
+				GetJSON("uptime", unit, R.uptime, (uint64_t)0);
+				if (unit.contains("memory")) {
+					auto memory = unit["memory"];
+					R.has_memory = true;
+					GetJSON("free", memory, R.memory_free, (uint64_t)0);
+					GetJSON("total", memory, R.memory_total, (uint64_t)0);
+				}
+			}
+
+			DTP.timestamp = R.localtime;
+
+			std::map<uint, std::pair<uint, uint>> radio_map;
+			if (State->contains("radios") && (*State)["radios"].is_array()) {
+				auto radios = (*State)["radios"];
+				uint radio_index = 0;
+				for (const auto &radio : radios) {
+					if (radio.contains("channel")) {
+						AnalyticsObjects::RadioTimePoint RTP;
+						GetJSON("channel", radio, RTP.channel, (uint64_t)2);
+						if (radio.contains("band") && radio["band"].is_array()) {
+							auto BandArray = radio["band"];
+							RTP.band = BandToInt(BandArray[0]);
+						} else {
+							RTP.band = RTP.channel <= 16 ? 2 : 5;
+						}
+						radio_map[radio_index++] = std::make_pair(RTP.band, RTP.channel);
+						GetJSON("busy_ms", radio, RTP.busy_ms, (uint64_t)0);
+						GetJSON("receive_ms", radio, RTP.receive_ms, (uint64_t)0);
+						GetJSON("transmit_ms", radio, RTP.transmit_ms, (uint64_t)0);
+						GetJSON("active_ms", radio, RTP.active_ms, (uint64_t)0);
+						GetJSON("tx_power", radio, RTP.tx_power, (uint64_t)0);
+						GetJSON("active_ms", radio, RTP.active_ms, (uint64_t)0);
+						GetJSON("channel", radio, RTP.channel, (uint64_t)0);
+						GetJSON("temperature", radio, RTP.temperature, (int64_t)20);
+						if (radio.contains("channel_width") && !radio["channel_width"].is_null()) {
+							if (radio["channel_width"].is_string()) {
+								std::string C = radio["channel_width"];
+								RTP.channel_width = std::strtoull(C.c_str(), nullptr, 10);
+							} else if (radio["channel_width"].is_number_integer()) {
+								RTP.channel_width = radio["channel_width"];
+							} else {
+								RTP.channel_width = 20;
+							}
+						}
+						if (RTP.temperature == 0)
+							RTP.temperature = 20;
+						GetJSON("noise", radio, RTP.noise, (int64_t)-90);
+						if (RTP.noise == 0)
+							RTP.noise = -90;
+						DTP.radio_data.push_back(RTP);
+					}
+				}
+			}
+
+			//  now that we know the radio bands, look for associations
+			auto interfaces = (*State)["interfaces"];
+			R.associations_2g = R.associations_5g = R.associations_6g = 0;
+			for (const auto &interface : interfaces) {
+				std::string InterfaceName = fmt::format(
+					"{}: {}", R.serialNumber,
+					interface.contains("name") ? to_string(interface["name"]) : "unknown");
+				if (interface.contains("counters")) {
+					auto counters = interface["counters"];
+					GetJSON("collisions", counters, DTP.ap_data.collisions, (uint64_t)0);
+					GetJSON("multicast", counters, DTP.ap_data.multicast, (uint64_t)0);
+					GetJSON("rx_bytes", counters, DTP.ap_data.rx_bytes, (uint64_t)0);
+					GetJSON("rx_dropped", counters, DTP.ap_data.rx_dropped, (uint64_t)0);
+					GetJSON("rx_errors", counters, DTP.ap_data.rx_errors, (uint64_t)0);
+					GetJSON("rx_packets", counters, DTP.ap_data.rx_packets, (uint64_t)0);
+					GetJSON("tx_bytes", counters, DTP.ap_data.tx_bytes, (uint64_t)0);
+					GetJSON("tx_dropped", counters, DTP.ap_data.tx_dropped, (uint64_t)0);
+					GetJSON("tx_errors", counters, DTP.ap_data.tx_errors, (uint64_t)0);
+					GetJSON("tx_packets", counters, DTP.ap_data.tx_packets, (uint64_t)0);
+				}
+
+				InterfaceClientEntryMap_t ICEM;
+				if (interface.contains("clients") && interface["clients"].is_array()) {
+					try {
+						auto Clients = interface["clients"];
+						for (const auto &client : Clients) {
+							if (client.contains("mac") && client["mac"].is_string()) {
+								InterfaceClientEntry E;
+								if (client.contains("ipv4_addresses") &&
+									client["ipv4_addresses"].is_array()) {
+									for (const auto &ip : client["ipv4_addresses"]) {
+										E.ipv4_addresses.push_back(ip);
+									}
+								}
+								if (client.contains("ipv6_addresses") &&
+									client["ipv6_addresses"].is_array()) {
+									for (const auto &ip : client["ipv6_addresses"]) {
+										E.ipv6_addresses.push_back(ip);
+									}
+								}
+								auto M = mac_filter(client["mac"]);
+								ICEM[M] = E;
+							}
+						}
+					} catch (...) {
+					}
+				}
+
+				if (interface.contains("ssids")) {
+					auto ssids = interface["ssids"];
+					for (const auto &ssid : ssids) {
+						AnalyticsObjects::SSIDTimePoint SSIDTP;
+						uint radio_location = 0;
+						SSIDTP.band = 2;
+
+						if (ssid.contains("band")) {
+							std::string Band = ssid["band"];
+							SSIDTP.band = BandToInt(Band);
+							auto radio = ssid["radio"];
+							if (radio.contains("$ref")) {
+								auto ref = radio["$ref"];
+								auto radio_parts = Poco::StringTokenizer(ref, "/");
+								if (radio_parts.count() == 3) {
+									radio_location =
+										std::strtol(radio_parts[2].c_str(), nullptr, 10);
+									if (radio_map.find(radio_location) != radio_map.end()) {
+										SSIDTP.channel = radio_map[radio_location].second;
+									}
+								}
+							}
+						} else if (ssid.contains("radio")) {
+							auto radio = ssid["radio"];
+							if (radio.contains("$ref")) {
+								auto ref = radio["$ref"];
+								auto radio_parts = Poco::StringTokenizer(ref, "/");
+								if (radio_parts.count() == 3) {
+									radio_location =
+										std::strtol(radio_parts[2].c_str(), nullptr, 10);
+									if (radio_map.find(radio_location) != radio_map.end()) {
+										SSIDTP.band = radio_map[radio_location].first;
+										SSIDTP.channel = radio_map[radio_location].second;
+									}
+								}
+							}
+						}
+						std::string bssid, ssid_name;
+						GetJSON("bssid", ssid, bssid, std::string{""});
+						SSIDTP.bssid = MACAddress::FromString(bssid);
+						GetJSON("mode", ssid, SSIDTP.mode, std::string{""});
+						GetJSON("ssid", ssid, ssid_name, std::string{""});
+						SSIDTP.ssid = SSIDName(ssid_name);
+						if (ssid.contains("associations") && ssid["associations"].is_array()) {
+							auto associations = ssid["associations"];
+							auto radio_it = radio_map.find(radio_location);
+							if (radio_it != radio_map.end()) {
+								auto the_radio = radio_it->second.first;
+								if (the_radio == 2)
+									R.associations_2g += associations.size();
+								else if (the_radio == 5)
+									R.associations_5g += associations.size();
+								else if (the_radio == 6)
+									R.associations_6g += associations.size();
+							}
+							for (const auto &association : associations) {
+								AnalyticsObjects::UETimePoint TP;
+								std::string station;
+								GetJSON("station", association, station, std::string{});
+								TP.station = MACAddress::FromString(station);
+								GetJSON("rssi", association, TP.rssi, (int64_t)0);
+								GetJSON("tx_bytes", association, TP.tx_bytes, (uint64_t)0);
+								GetJSON("rx_bytes", association, TP.rx_bytes, (uint64_t)0);
+								GetJSON("tx_duration", association, TP.tx_duration,
+										(uint64_t)0);
+								GetJSON("rx_packets", association, TP.rx_packets, (uint64_t)0);
+								GetJSON("tx_packets", association, TP.tx_packets, (uint64_t)0);
+								GetJSON("tx_retries", association, TP.tx_retries, (uint64_t)0);
+								GetJSON("tx_failed", association, TP.tx_failed, (uint64_t)0);
+								GetJSON("connected", association, TP.connected, (uint64_t)0);
+								GetJSON("inactive", association, TP.inactive, (uint64_t)0);
+								if (association.contains("fingerprint")) {
+									TP.fingerprint.json = association["fingerprint"].dump();
+								}
+
+								AnalyticsObjects::WifiClientHistory WFH;
+								WFH.station_id = TP.station;
+								WFH.bssid = SSIDTP.bssid;
+								WFH.ssid = SSIDTP.ssid;
+								WFH.rssi = TP.rssi;
+								GetJSON("rx_rate", "bitrate", association, WFH.rx_bitrate,
+										(uint32_t)0);
+								GetJSON("rx_rate", "chwidth", association, WFH.rx_chwidth,
+										(uint32_t)0);
+								GetJSON("rx_rate", "mcs", association, WFH.rx_mcs, (uint16_t)0);
+								GetJSON("rx_rate", "nss", association, WFH.rx_nss, (uint16_t)0);
+								GetJSON("rx_rate", "vht", association, WFH.rx_vht, false);
+								GetJSON("tx_rate", "bitrate", association, WFH.tx_bitrate,
+										(uint32_t)0);
+								GetJSON("tx_rate", "chwidth", association, WFH.tx_chwidth,
+										(uint32_t)0);
+								GetJSON("tx_rate", "mcs", association, WFH.tx_mcs, (uint16_t)0);
+								GetJSON("tx_rate", "nss", association, WFH.tx_nss, (uint16_t)0);
+								GetJSON("tx_rate", "vht", association, WFH.tx_vht, false);
+								GetJSON("rx_bytes", association, WFH.rx_bytes, (uint64_t)0);
+								GetJSON("tx_bytes", association, WFH.tx_bytes, (uint64_t)0);
+								GetJSON("rx_duration", association, WFH.rx_duration,
+										(uint64_t)0);
+								GetJSON("tx_duration", association, WFH.tx_duration,
+										(uint64_t)0);
+								GetJSON("rx_packets", association, WFH.rx_packets, (uint64_t)0);
+								GetJSON("tx_packets", association, WFH.tx_packets, (uint64_t)0);
+
+								// try to locate the IP addresses
+								auto ClientInfo = ICEM.find(WFH.station_id.ToHex());
+								if (ClientInfo != end(ICEM)) {
+									if (!ClientInfo->second.ipv4_addresses.empty()) {
+										WFH.ipv4 = ClientInfo->second.ipv4_addresses[0];
+									}
+									if (!ClientInfo->second.ipv6_addresses.empty()) {
+										WFH.ipv6 = ClientInfo->second.ipv6_addresses[0];
+									}
+								}
+
+								for (const auto &rd : DTP.radio_data) {
+									if (rd.band == SSIDTP.band) {
+										WFH.channel_width = rd.channel_width;
+										WFH.noise = rd.noise;
+										WFH.tx_power = rd.tx_power;
+										WFH.channel = rd.channel;
+										WFH.active_ms = rd.active_ms;
+										WFH.busy_ms = rd.busy_ms;
+										WFH.receive_ms = rd.receive_ms;
+										break;
+									}
+								}
+
+								WFH.mode = SSIDTP.mode;
+								GetJSON("ack_signal", association, WFH.ack_signal, (int64_t)0);
+								GetJSON("ack_signal_avg", association, WFH.ack_signal_avg,
+										(int64_t)0);
+								GetJSON("connected", association, WFH.connected, (uint64_t)0);
+								GetJSON("inactive", association, WFH.inactive, (uint64_t)0);
+								GetJSON("tx_retries", association, WFH.tx_retries, (uint64_t)0);
+
+								//	Was handed to the client cache and the database here.
+								if (!WFH.station_id.Empty())
+									R.clients.push_back(WFH);
+
+								if (association.contains("tid_stats") &&
+									association["tid_stats"].is_array()) {
+									auto tid_stats = association["tid_stats"];
+									for (const auto &tid_stat : tid_stats) {
+										AnalyticsObjects::TIDstat_entry E;
+										GetJSON("rx_msdu", tid_stat, E.rx_msdu, (uint64_t)0);
+										GetJSON("tx_msdu", tid_stat, E.tx_msdu, (uint64_t)0);
+										GetJSON("tx_msdu_failed", tid_stat, E.tx_msdu_failed,
+												(uint64_t)0);
+										GetJSON("tx_msdu_retries", tid_stat, E.tx_msdu_retries,
+												(uint64_t)0);
+										TP.tidstats.push_back(E);
+									}
+								}
+
+								if (association.contains("tx_rate")) {
+									auto tx_rate = association["tx_rate"];
+									GetJSON("bitrate", tx_rate, TP.tx_rate.bitrate, (uint64_t)0);
+									GetJSON("mcs", tx_rate, TP.tx_rate.mcs, (uint64_t)0);
+									GetJSON("nss", tx_rate, TP.tx_rate.nss, (uint64_t)0);
+									GetJSON("chwidth", tx_rate, TP.tx_rate.chwidth, (uint64_t)0);
+									GetJSON("ht", tx_rate, TP.tx_rate.ht, false);
+									GetJSON("sgi", tx_rate, TP.tx_rate.sgi, false);
+								}
+
+								if (association.contains("rx_rate")) {
+									auto rx_rate = association["rx_rate"];
+									GetJSON("bitrate", rx_rate, TP.rx_rate.bitrate, (uint64_t)0);
+									GetJSON("mcs", rx_rate, TP.rx_rate.mcs, (uint64_t)0);
+									GetJSON("nss", rx_rate, TP.rx_rate.nss, (uint64_t)0);
+									GetJSON("chwidth", rx_rate, TP.rx_rate.chwidth, (uint64_t)0);
+									GetJSON("ht", rx_rate, TP.rx_rate.ht, false);
+									GetJSON("sgi", rx_rate, TP.rx_rate.sgi, false);
+								}
+								SSIDTP.associations.push_back(TP);
+							}
+						}
+						DTP.ssid_data.push_back(SSIDTP);
+					}
+				}
+			}
+		}
+	} // namespace
+
+	bool ParseStateDom(const std::string &Message, StateReport &Report) {
+		try {
+			//	StateReceiver::run
+			nlohmann::json msg = nlohmann::json::parse(Message);
+			if (!msg.contains("payload"))
+				return false;
+			auto payload = msg["payload"];
+			if (!payload.contains("state") || !payload.contains("serial"))
+				return false;
+			Report.serialNumber = payload["serial"].get<std::string>();
+			Report.has_state = true;
+			auto state = std::make_shared<nlohmann::json>(payload["state"]);
+			UpdateStats(state, Report);
+			return true;
+		} catch (...) {
+		}
+		return false;
+	}
+
+} // namespace OpenWifi::Benchmark
@@ -0,0 +1,18 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "StateParser.h"
+#include <string>
+
+namespace OpenWifi::Benchmark {
+
+	//	The state message path ParseState() replaced: StateReceiver parsed the message into a
+	//	DOM and copied its state out, then AP::UpdateStats walked that copy. Kept here, as it
+	//	was, so that the parse benchmark compares against the real thing. Fills the same fields
+	//	ParseState() does. Returns false when the message is not a state message.
+	bool ParseStateDom(const std::string &Message, StateReport &Report);
+
+} // namespace OpenWifi::Benchmark
@@ -0,0 +1,119 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Benchmark.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/ConsoleChannel.h"
+#include "Poco/Data/SQLite/Connector.h"
+#include "Poco/Util/Application.h"
+#ifndef SMALL_BUILD
+#include "Poco/Data/PostgreSQL/Connector.h"
+#endif
+#include <iostream>
+
+namespace OpenWifi {
+	//	The service sources are linked in for their storage and parsing code, but the service
+	//	itself never runs here.
+	void DaemonPostInitialization([[maybe_unused]] Poco::Util::Application &self) {}
+} // namespace OpenWifi
+
+namespace OpenWifi::Benchmark {
+
+	uint64_t Arguments::GetInt(const std::string &Name, uint64_t Default) const {
+		auto It = Values.find(Name);
+		return It == Values.end() ? Default : std::strtoull(It->second.c_str(), nullptr, 10);
+	}
+
+	std::string Arguments::Get(const std::string &Name, const std::string &Default) const {
+		auto It = Values.find(Name);
+		return It == Values.end() ? Default : It->second;
+	}
+
+	bool OpenDatabase(const Arguments &Args, Database &DB, Poco::Logger &L) {
+		auto Spec = Args.Get("db");
+		auto Colon = Spec.find(':');
+		if (Colon == std::string::npos) {
+			poco_error(L, "db=sqlite:<file> or db=postgresql:<connection string> is required.");
+			return false;
+		}
+		auto Kind = Spec.substr(0, Colon);
+		DB.ConnectionString = Spec.substr(Colon + 1);
+		if (Kind == "sqlite") {
+			Poco::Data::SQLite::Connector::registerConnector();
+			DB.Type = sqlite;
+			DB.Pool = std::make_unique<Poco::Data::SessionPool>(Poco::Data::SQLite::Connector::KEY,
+																DB.ConnectionString, 1, 8);
+			return true;
+		}
+#ifndef SMALL_BUILD
+		if (Kind == "postgresql") {
+			Poco::Data::PostgreSQL::Connector::registerConnector();
+			DB.Type = pgsql;
+			DB.Pool = std::make_unique<Poco::Data::SessionPool>(
+				Poco::Data::PostgreSQL::Connector::KEY, DB.ConnectionString, 1, 8);
+			return true;
+		}
+#endif
+		poco_error(L, "Unsupported database: " + Kind);
+		return false;
+	}
+
+} // namespace OpenWifi::Benchmark
+
+static void Usage() {
+	std::cout
+		<< "usage: owanalytics-bench <benchmark> [name=value]...\n"
+		   "  ingest db=<database> [rows=100000] [batch=500]\n"
+		   "      Writes synthetic WiFi client history rows into a wfhbenchmark table, one\n"
+		   "      statement per row, with multi-row INSERTs, then with COPY on PostgreSQL.\n"
+		   "  codec db=<database> [points=10000]\n"
+		   "      Encodes and decodes the latest time points of the timepoints table with each\n"
+		   "      encoding, and checks that they come back unchanged.\n"
+		   "  parse <state message file>... [iterations=200]\n"
+		   "      Times ParseState() against the DOM path it replaced on each message, such as\n"
+		   "      stats_sample/*.json and src/last_stats_2.json, and checks that they agree.\n"
+		   "  mailbox [messages=100000] [capacity=1000] [rate=0]\n"
+		   "      Three producers post messages to one consumer through the board mailbox, then\n"
+		   "      through a BoundedQueue. rate is per producer, in messages/s, 0 for no limit.\n"
+		   "databases: sqlite:<file> or postgresql:<connection string>. Use a scratch database:\n"
+		   "benchmarks create and empty their own tables in it.\n";
+}
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		Usage();
+		return Poco::Util::Application::EXIT_USAGE;
+	}
+
+	Poco::AutoPtr<Poco::ConsoleChannel> Console(new Poco::ConsoleChannel);
+	Poco::Logger::root().setChannel(Console);
+	auto &Logger = Poco::Logger::get("owanalytics-bench");
+
+	OpenWifi::Benchmark::Arguments Args;
+	for (int i = 2; i < argc; ++i) {
+		std::string Arg(argv[i]);
+		auto Equal = Arg.find('=');
+		if (Equal == std::string::npos)
+			Args.Files.push_back(Arg);
+		else
+			Args.Values[Arg.substr(0, Equal)] = Arg.substr(Equal + 1);
+	}
+
+	try {
+		std::string Name(argv[1]);
+		if (Name == "ingest")
+			return OpenWifi::Benchmark::Ingest(Args, Logger);
+		if (Name == "codec")
+			return OpenWifi::Benchmark::Codec(Args, Logger);
+		if (Name == "parse")
+			return OpenWifi::Benchmark::Parse(Args, Logger);
+		if (Name == "mailbox")
+			return OpenWifi::Benchmark::Mailbox(Args, Logger);
+	} catch (const Poco::Exception &E) {
+		Logger.log(E);
+		return Poco::Util::Application::EXIT_SOFTWARE;
+	}
+	Usage();
+	return Poco::Util::Application::EXIT_USAGE;
+}
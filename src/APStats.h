@@ -4,20 +4,38 @@
 
 #pragma once
 
+#include "BandwidthSeries.h"
+#include "BoardAggregator.h"
 #include "Poco/Logger.h"
 #include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include "StateParser.h"
+#include "TimePointRing.h"
 #include "framework/utils.h"
 #include "nlohmann/json.hpp"
 #include <mutex>
+#include <unordered_map>
 
 namespace OpenWifi {
 
-	struct InterfaceClientEntry {
-		std::vector<std::string> ipv4_addresses;
-		std::vector<std::string> ipv6_addresses;
-	};
+	//	What an AP needs to remember from its previous state report to compute the next deltas:
+	//	the cumulative counters only, stations keyed by MAC and radios by channel.
+	struct APBaseline {
+		struct BaseStation {
+			uint64_t tx_bytes = 0, rx_bytes = 0, tx_packets = 0, rx_packets = 0, tx_failed = 0,
+					 tx_retries = 0, tx_duration = 0;
+		};
+		struct BaseRadio {
+			uint64_t active_ms = 0, busy_ms = 0, receive_ms = 0, transmit_ms = 0;
+		};
+
+		uint64_t timestamp = 0;
+		uint64_t tx_bytes = 0, rx_bytes = 0, tx_packets = 0, rx_packets = 0, tx_dropped = 0,
+				 rx_dropped = 0, tx_errors = 0, rx_errors = 0;
+		std::unordered_map<uint64_t, BaseStation> stations;
+		std::unordered_map<uint64_t, BaseRadio> radios;
 
-	using InterfaceClientEntryMap_t = std::map<std::string, InterfaceClientEntry>;
+		void Set(const AnalyticsObjects::DeviceTimePoint &DTP);
+	};
 
 	class AP {
 	  public:
@@ -27,17 +45,23 @@ namespace OpenWifi {
 			DI_.serialNumber = Utils::IntToSerialNumber(mac);
 		}
 
-		void UpdateStats(const std::shared_ptr<nlohmann::json> &State);
+		//	Returns true when the report produced deltas, described by LastSample(). A point that
+		//	gets stored is also added to the board's Aggregates.
+		bool UpdateStats(const std::shared_ptr<StateReport> &Report, BoardAggregator &Aggregates);
 		void UpdateConnection(const std::shared_ptr<nlohmann::json> &Connection);
 		void UpdateHealth(const std::shared_ptr<nlohmann::json> &Health);
 
 		[[nodiscard]] const AnalyticsObjects::DeviceInfo &Info() const { return DI_; }
+		[[nodiscard]] const BandwidthSample &LastSample() const { return Sample_; }
+		[[nodiscard]] TimePointRing &TimePoints() { return Hot_; }
 
 	  private:
 		std::string venue_id_;
 		std::string boardId_;
 		AnalyticsObjects::DeviceInfo DI_;
-		AnalyticsObjects::DeviceTimePoint tp_base_;
+		APBaseline Base_;
+		BandwidthSample Sample_;
+		TimePointRing Hot_;
 		bool got_health = false, got_connection = false, got_base = false;
 		Poco::Logger &Logger_;
 		inline Poco::Logger &Logger() { return Logger_; }
@@ -0,0 +1,149 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "BandwidthSeries.h"
+#include "framework/utils.h"
+
+namespace OpenWifi {
+
+	static int BandIndex(uint64_t Band) {
+		switch (Band) {
+		case 2:
+			return AnalyticsObjects::band_2g;
+		case 5:
+			return AnalyticsObjects::band_5g;
+		case 6:
+			return AnalyticsObjects::band_6g;
+		default:
+			return -1;
+		}
+	}
+
+	void BandwidthSeries::Configure(uint64_t BucketWidth, uint64_t Retention) {
+		std::lock_guard G(Mutex_);
+		Width_ = BucketWidth ? BucketWidth : 1;
+		//	A whole number of buckets, so that the ring holds every bucket a sample is kept for.
+		Retention_ = std::max<uint64_t>((Retention + Width_ - 1) / Width_, 1) * Width_;
+		Newest_ = 0;
+		Buckets_.clear();
+		Buckets_.resize(Retention_ / Width_);
+	}
+
+	void BandwidthSeries::Add(uint64_t SerialNumber, const BandwidthSample &Sample) {
+		std::lock_guard G(Mutex_);
+		if (Buckets_.empty())
+			return;
+
+		//	One AP whose clock is ahead must not push every other AP out of the ring.
+		auto Timestamp = std::min<uint64_t>(Sample.timestamp, Utils::Now());
+		auto Start = Timestamp - (Timestamp % Width_);
+		if (Start + Retention_ <= Newest_)
+			return;
+		Newest_ = std::max(Newest_, Start);
+
+		auto &B = Buckets_[(Start / Width_) % Buckets_.size()];
+		if (B.start != Start) {
+			//	Recycled from an expired period: clear() keeps the maps' buckets allocated.
+			B.start = Start;
+			B.total = Counter{};
+			B.bands.fill(Counter{});
+			B.aps.clear();
+			B.ssids.clear();
+		}
+
+		B.total.Add(Sample.tx_bytes, Sample.rx_bytes);
+		B.aps[SerialNumber].Add(Sample.tx_bytes, Sample.rx_bytes);
+		for (const auto &ssid : Sample.ssids) {
+			B.ssids[ssid.ssid.Id()].Add(ssid.tx_bytes, ssid.rx_bytes);
+			auto Band = BandIndex(ssid.band);
+			if (Band >= 0)
+				B.bands[Band].Add(ssid.tx_bytes, ssid.rx_bytes);
+		}
+	}
+
+	void BandwidthSeries::Get(uint64_t start, uint64_t end, uint64_t interval,
+							  AnalyticsObjects::BandwidthAnalysis &BW) {
+		std::lock_guard G(Mutex_);
+
+		start -= start % Width_;
+		if (end <= start)
+			return;
+		auto RoundUp = [this](uint64_t v) {
+			return std::max(Width_, (v + Width_ - 1) / Width_ * Width_);
+		};
+		interval = RoundUp(interval);
+		auto Points = (end - start + interval - 1) / interval;
+		if (Points > MaxPoints) {
+			interval = RoundUp((end - start + MaxPoints - 1) / MaxPoints);
+			Points = (end - start + interval - 1) / interval;
+		}
+
+		BW.start = start;
+		BW.end = end;
+		BW.interval = interval;
+		std::vector<AnalyticsObjects::BandwidthAnalysisEntry> Empty(Points);
+		for (uint64_t i = 0; i < Points; ++i)
+			Empty[i].timestamp = start + i * interval;
+		BW.total = Empty;
+
+		//	Series are only created for keys that show up in the requested period.
+		auto SeriesFor = [&Empty](std::vector<AnalyticsObjects::BandwidthAnalysisSeries> &Series,
+								  std::unordered_map<uint64_t, std::size_t> &Index, uint64_t Key,
+								  auto &&KeyName) -> AnalyticsObjects::BandwidthAnalysisSeries & {
+			auto It = Index.find(Key);
+			if (It != Index.end())
+				return Series[It->second];
+			Index[Key] = Series.size();
+			auto &S = Series.emplace_back();
+			S.key = KeyName();
+			S.points = Empty;
+			return S;
+		};
+		auto AddTo = [](AnalyticsObjects::BandwidthAnalysisEntry &E, const Counter &C) {
+			E.tx_bytes += C.tx_bytes;
+			E.rx_bytes += C.rx_bytes;
+		};
+
+		std::unordered_map<uint64_t, std::size_t> APIndex, SSIDIndex, BandSeriesIndex;
+		const char *BandNames[] = {"2G", "5G", "6G"};
+		for (const auto &B : Buckets_) {
+			if (B.start < start || B.start >= end || B.start + Retention_ <= Newest_)
+				continue;
+			auto Slot = (B.start - start) / interval;
+			AddTo(BW.total[Slot], B.total);
+			for (const auto &[serialNumber, C] : B.aps) {
+				auto &S = SeriesFor(BW.aps, APIndex, serialNumber,
+									[&] { return Utils::IntToSerialNumber(serialNumber); });
+				AddTo(S.points[Slot], C);
+			}
+			for (const auto &[ssid_id, C] : B.ssids) {
+				auto &S = SeriesFor(BW.ssids, SSIDIndex, ssid_id,
+									[&] { return SSIDDictionary()->Get(ssid_id); });
+				AddTo(S.points[Slot], C);
+			}
+			for (std::size_t Band = 0; Band < B.bands.size(); ++Band) {
+				if (B.bands[Band].tx_bytes == 0 && B.bands[Band].rx_bytes == 0)
+					continue;
+				auto &S =
+					SeriesFor(BW.bands, BandSeriesIndex, Band, [&] { return BandNames[Band]; });
+				AddTo(S.points[Slot], B.bands[Band]);
+			}
+		}
+
+		//	The last point may cover less than a full interval.
+		auto Rates = [interval,
+					  end](std::vector<AnalyticsObjects::BandwidthAnalysisEntry> &Points) {
+			for (auto &E : Points) {
+				auto Span = std::min(interval, end - E.timestamp);
+				E.tx_bytes_bw = E.tx_bytes / Span;
+				E.rx_bytes_bw = E.rx_bytes / Span;
+			}
+		};
+		Rates(BW.total);
+		for (auto *List : {&BW.aps, &BW.ssids, &BW.bands})
+			for (auto &S : *List)
+				Rates(S.points);
+	}
+
+} // namespace OpenWifi
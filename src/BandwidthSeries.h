@@ -0,0 +1,71 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	Bytes moved by one AP since its previous state report, as computed by AP::UpdateStats.
+	struct BandwidthSample {
+		struct SSID {
+			SSIDName ssid;
+			uint64_t band = 0;
+			uint64_t tx_bytes = 0, rx_bytes = 0;
+		};
+
+		uint64_t timestamp = 0;
+		uint64_t tx_bytes = 0, rx_bytes = 0;
+		std::vector<SSID> ssids;
+	};
+
+	//	Rolling bandwidth of one venue, kept in memory so that bandwidth queries never touch the
+	//	timepoints table. Samples are summed into fixed width buckets (per AP, per SSID, per band
+	//	and for the whole venue) held in a ring covering the retention period. A sample is counted
+	//	in the bucket holding its timestamp, or the current time if that is in the future.
+	class BandwidthSeries {
+	  public:
+		static constexpr uint64_t MaxPoints = 1440;
+
+		void Configure(uint64_t BucketWidth, uint64_t Retention);
+		void Add(uint64_t SerialNumber, const BandwidthSample &Sample);
+
+		//	Totals over [start, end) in steps of interval seconds. The interval is rounded up to a
+		//	whole number of buckets, and widened if the answer would exceed MaxPoints per series.
+		void Get(uint64_t start, uint64_t end, uint64_t interval,
+				 AnalyticsObjects::BandwidthAnalysis &BW);
+
+		inline uint64_t BucketWidth() const { return Width_; }
+
+	  private:
+		struct Counter {
+			uint64_t tx_bytes = 0, rx_bytes = 0;
+
+			inline void Add(uint64_t tx, uint64_t rx) {
+				tx_bytes += tx;
+				rx_bytes += rx;
+			}
+		};
+
+		struct Bucket {
+			uint64_t start = 0;
+			Counter total;
+			std::array<Counter, 3> bands;
+			std::unordered_map<uint64_t, Counter> aps;
+			std::unordered_map<uint32_t, Counter> ssids;
+		};
+
+		std::mutex Mutex_;
+		uint64_t Width_ = 60;
+		uint64_t Retention_ = 86400;
+		uint64_t Newest_ = 0;
+		std::vector<Bucket> Buckets_;
+	};
+
+} // namespace OpenWifi
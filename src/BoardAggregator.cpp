@@ -0,0 +1,167 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "BoardAggregator.h"
+#include "StorageService.h"
+
+namespace OpenWifi {
+
+	void BoardAggregator::Configure(uint64_t BucketWidth) {
+		std::lock_guard G(S_->Mutex);
+		if (BucketWidth == 0)
+			BucketWidth = 60;
+		if (BucketWidth != S_->Width) {
+			//	Open buckets keep the width they were started with.
+			CloseBefore(UINT64_MAX);
+			S_->Width = BucketWidth;
+		}
+	}
+
+	void BoardAggregator::Add(const AnalyticsObjects::DeviceTimePoint &P) {
+		std::lock_guard G(S_->Mutex);
+		auto Start = P.timestamp - (P.timestamp % S_->Width);
+		auto &B = S_->Open[Start];
+		if (B.points == 0) {
+			B.boardId = S_->boardId;
+			B.timestamp = Start;
+		}
+		B.Add(P);
+		S_->Newest = std::max(S_->Newest, Start);
+		if (S_->Newest >= S_->Width)
+			CloseBefore(S_->Newest - S_->Width);
+	}
+
+	void BoardAggregator::Close() {
+		std::lock_guard G(S_->Mutex);
+		CloseBefore(UINT64_MAX);
+	}
+
+	void BoardAggregator::Discard() {
+		//	Waits for a bucket being written, so that deleting the board's rows next gets it too.
+		std::lock_guard W(S_->WriteMutex);
+		std::lock_guard G(S_->Mutex);
+		S_->Open.clear();
+		S_->Pending.clear();
+	}
+
+	//	Called with Mutex held.
+	void BoardAggregator::CloseBefore(uint64_t Limit) {
+		auto It = S_->Open.begin();
+		while (It != S_->Open.end() && It->first < Limit) {
+			auto [Pending, Fresh] = S_->Pending.try_emplace(It->first, std::move(It->second));
+			if (!Fresh)
+				Pending->second.Merge(It->second);
+			//	Still queued flushes of the same bucket are coalesced by the writer queue.
+			auto Key =
+				std::hash<const void *>{}(S_.get()) ^ (It->first * 0x9E3779B97F4A7C15ULL);
+			StorageService()->BoardStatsWriter().Write(Key, Flush{S_, It->first});
+			It = S_->Open.erase(It);
+		}
+	}
+
+	bool BoardAggregator::Write(const std::vector<Flush> &Batch) {
+		for (const auto &F : Batch) {
+			auto &S = *F.Source;
+			std::lock_guard W(S.WriteMutex);
+			AnalyticsObjects::BoardStatsBucket B;
+			{
+				std::lock_guard G(S.Mutex);
+				auto It = S.Pending.find(F.timestamp);
+				//	Already written, by an earlier flush of the same bucket.
+				if (It == S.Pending.end())
+					continue;
+				B = std::move(It->second);
+				S.Pending.erase(It);
+			}
+			if (!StorageService()->BoardStatsDB().Merge(B)) {
+				std::lock_guard G(S.Mutex);
+				auto [It, Fresh] = S.Pending.try_emplace(F.timestamp, B);
+				if (!Fresh)
+					It->second.Merge(B);
+				return false;
+			}
+			S.Flushed++;
+		}
+		return true;
+	}
+
+	uint64_t BoardAggregator::OpenBuckets() {
+		std::lock_guard G(S_->Mutex);
+		return S_->Open.size();
+	}
+
+	uint64_t BoardAggregator::PendingBuckets() {
+		std::lock_guard G(S_->Mutex);
+		return S_->Pending.size();
+	}
+
+	//	The buckets answer for [from, ...] if no time point of the board was stored between from
+	//	and its first bucket, which is where statistics started being kept.
+	static bool Covered(const std::string &boardId, uint64_t from, uint64_t FirstBucket) {
+		return from >= FirstBucket ||
+			   !StorageService()->TimePointsDB().HasPoints(boardId, from, FirstBucket - 1);
+	}
+
+	static void Fill(const std::map<uint64_t, AnalyticsObjects::BoardStatsBucket> &Buckets,
+					 uint64_t MaxRecords,
+					 std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats) {
+		for (const auto &[timestamp, B] : Buckets) {
+			if (Stats.size() >= MaxRecords)
+				break;
+			B.Fill(Stats.emplace_back());
+		}
+	}
+
+	bool BoardAggregator::Get(uint64_t from, uint64_t end, uint64_t MaxRecords,
+							  std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats) {
+		std::map<uint64_t, AnalyticsObjects::BoardStatsBucket> Buckets;
+		uint64_t FirstBucket;
+		{
+			std::lock_guard W(S_->WriteMutex);
+			uint64_t Width;
+			{
+				std::lock_guard G(S_->Mutex);
+				Width = S_->Width;
+			}
+			from -= from % Width;
+			std::vector<AnalyticsObjects::BoardStatsBucket> Stored;
+			auto &DB = StorageService()->BoardStatsDB();
+			DB.SelectRecords(S_->boardId, from, end, MaxRecords, Stored);
+			FirstBucket = DB.FirstBucket(S_->boardId);
+			for (auto &B : Stored)
+				Buckets[B.timestamp] = std::move(B);
+
+			//	Ingest only waits for this copy, never for the database.
+			std::lock_guard G(S_->Mutex);
+			for (const auto *Buckets_ : {&S_->Pending, &S_->Open}) {
+				if (!Buckets_->empty())
+					FirstBucket = std::min(FirstBucket, Buckets_->begin()->first);
+				for (auto It = Buckets_->lower_bound(from);
+					 It != Buckets_->end() && (end == 0 || It->first <= end); ++It) {
+					auto &B = Buckets[It->first];
+					B.timestamp = It->first;
+					B.Merge(It->second);
+				}
+			}
+		}
+		if (Buckets.empty() || !Covered(S_->boardId, from, FirstBucket))
+			return false;
+		Fill(Buckets, MaxRecords, Stats);
+		return true;
+	}
+
+	bool BoardAggregator::GetStored(const std::string &boardId, uint64_t from, uint64_t end,
+									uint64_t MaxRecords,
+									std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats) {
+		std::vector<AnalyticsObjects::BoardStatsBucket> Stored;
+		auto &DB = StorageService()->BoardStatsDB();
+		if (!DB.SelectRecords(boardId, from, end, MaxRecords, Stored) ||
+			!Covered(boardId, from, DB.FirstBucket(boardId)))
+			return false;
+		for (const auto &B : Stored)
+			B.Fill(Stats.emplace_back());
+		return true;
+	}
+
+} // namespace OpenWifi
@@ -0,0 +1,82 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	Per bucket statistics of a board, built as its time points are stored so that
+	//	pointsStatsOnly queries read one row per bucket instead of every point.
+	//
+	//	A bucket stays open in memory until a point arrives two buckets later, which leaves one
+	//	bucket for late reports. It is then closed: kept as pending, and handed to the boardstats
+	//	storage writer, which merges it into the table. Ingest never waits for the database. A
+	//	point for a bucket already closed goes into a fresh open bucket that is merged into the
+	//	same row.
+	class BoardAggregator {
+	  public:
+		//	Shared with the storage writer, which may still hold closed buckets of a board that
+		//	is gone.
+		struct State {
+			std::string boardId;
+			//	Held while a closed bucket moves from pending to the table, and while a query reads
+			//	both, so that a query never sees a bucket twice or not at all. Taken before Mutex.
+			std::mutex WriteMutex;
+			std::mutex Mutex;
+			uint64_t Width = 60;
+			uint64_t Newest = 0;
+			std::map<uint64_t, AnalyticsObjects::BoardStatsBucket> Open, Pending;
+			std::atomic_uint64_t Flushed = 0;
+		};
+
+		//	What the storage writer is given: merge this closed bucket, if still pending.
+		struct Flush {
+			std::shared_ptr<State> Source;
+			uint64_t timestamp = 0;
+		};
+
+		explicit BoardAggregator(const std::string &boardId) : S_(std::make_shared<State>()) {
+			S_->boardId = boardId;
+		}
+
+		void Configure(uint64_t BucketWidth);
+		void Add(const AnalyticsObjects::DeviceTimePoint &P);
+		//	Closes every open bucket, when the board stops.
+		void Close();
+		//	Forgets every bucket not yet written, when the board is deleted.
+		void Discard();
+
+		//	Buckets starting in [from, end], stored, pending or open, oldest first. 0 means no
+		//	bound. False when the buckets do not cover the range: some of its time points were
+		//	stored before the board had statistics.
+		bool Get(uint64_t from, uint64_t end, uint64_t MaxRecords,
+				 std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats);
+
+		uint64_t OpenBuckets();
+		uint64_t PendingBuckets();
+		inline uint64_t Flushed() const { return S_->Flushed; }
+
+		//	The stored buckets only, for boards that are not being watched.
+		static bool GetStored(const std::string &boardId, uint64_t from, uint64_t end,
+							  uint64_t MaxRecords,
+							  std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats);
+
+		//	Run by the storage writer. False if the database failed: the buckets not yet
+		//	merged stay pending, and the batch can be retried.
+		static bool Write(const std::vector<Flush> &Batch);
+
+	  private:
+		std::shared_ptr<State> S_;
+
+		void CloseBefore(uint64_t Limit);
+	};
+
+} // namespace OpenWifi
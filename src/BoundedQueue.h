@@ -0,0 +1,199 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/JSON/Object.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	What a full queue does with a new item:
+	//		block:			the producer waits for room. This pushes back all the way to Kafka.
+	//		drop_oldest:	the oldest queued item is discarded.
+	//		coalesce:		an item already queued under the same key is replaced in place. If the
+	//						key is not queued and there is no room, the oldest item is discarded.
+	enum class OverloadPolicy { block, drop_oldest, coalesce };
+
+	inline OverloadPolicy OverloadPolicyFromString(const std::string &P) {
+		if (P == "drop_oldest")
+			return OverloadPolicy::drop_oldest;
+		if (P == "coalesce")
+			return OverloadPolicy::coalesce;
+		return OverloadPolicy::block;
+	}
+
+	inline const char *OverloadPolicyToString(OverloadPolicy P) {
+		switch (P) {
+		case OverloadPolicy::drop_oldest:
+			return "drop_oldest";
+		case OverloadPolicy::coalesce:
+			return "coalesce";
+		default:
+			return "block";
+		}
+	}
+
+	template <typename T> class BoundedQueue {
+	  public:
+		explicit BoundedQueue(std::size_t Capacity = 1000,
+							  OverloadPolicy Policy = OverloadPolicy::block)
+			: Capacity_(Capacity ? Capacity : 1), Policy_(Policy) {}
+
+		//	Must be called before any producer or consumer touches the queue. Also re-opens a queue
+		//	that was shut down.
+		inline void Configure(std::size_t Capacity, OverloadPolicy Policy) {
+			std::lock_guard G(Mutex_);
+			Capacity_ = Capacity ? Capacity : 1;
+			Policy_ = Policy;
+			Shutdown_ = false;
+		}
+
+		//	Key identifies the device the item belongs to and is only used by the coalesce policy.
+		//	Returns false if the queue was shut down.
+		bool Push(uint64_t Key, T &&Item) {
+			std::unique_lock G(Mutex_);
+			if (Shutdown_)
+				return false;
+
+			if (Policy_ == OverloadPolicy::coalesce) {
+				auto It = Index_.find(Key);
+				if (It != Index_.end()) {
+					It->second->second = std::move(Item);
+					Coalesced_++;
+					return true;
+				}
+			}
+
+			if (Items_.size() >= Capacity_) {
+				if (Policy_ == OverloadPolicy::block) {
+					auto Start = std::chrono::steady_clock::now();
+					NotFull_.wait(G, [this] { return Shutdown_ || Items_.size() < Capacity_; });
+					BlockedNs_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+									  std::chrono::steady_clock::now() - Start)
+									  .count();
+					if (Shutdown_)
+						return false;
+				} else {
+					PopFront();
+					Dropped_++;
+				}
+			}
+
+			Items_.emplace_back(Key, std::move(Item));
+			if (Policy_ == OverloadPolicy::coalesce)
+				Index_[Key] = std::prev(Items_.end());
+			G.unlock();
+			NotEmpty_.notify_one();
+			return true;
+		}
+
+		//	Waits for an item. Returns false once the queue is shut down.
+		bool Pop(T &Item) {
+			std::unique_lock G(Mutex_);
+			NotEmpty_.wait(G, [this] { return Shutdown_ || !Items_.empty(); });
+			if (Shutdown_)
+				return false;
+			Item = std::move(Items_.front().second);
+			PopFront();
+			G.unlock();
+			NotFull_.notify_one();
+			return true;
+		}
+
+		//	Does not wait. Returns false if the queue is empty or shut down.
+		bool TryPop(T &Item) {
+			std::unique_lock G(Mutex_);
+			if (Shutdown_ || Items_.empty())
+				return false;
+			Item = std::move(Items_.front().second);
+			PopFront();
+			G.unlock();
+			NotFull_.notify_one();
+			return true;
+		}
+
+		//	Waits for an item, then moves up to Max queued items to the end of Batch. With a Window,
+		//	it first waits up to that long after the first item for Max items to be queued. Unlike
+		//	Pop, items still queued when the queue is shut down are handed out: returns false only
+		//	once the queue is shut down and empty.
+		bool PopBatch(std::vector<T> &Batch, std::size_t Max,
+					  std::chrono::milliseconds Window = std::chrono::milliseconds(0)) {
+			std::unique_lock G(Mutex_);
+			NotEmpty_.wait(G, [this] { return Shutdown_ || !Items_.empty(); });
+			if (Items_.empty())
+				return false;
+			if (Window.count() > 0 && Items_.size() < Max)
+				NotEmpty_.wait_for(G, Window, [&] { return Shutdown_ || Items_.size() >= Max; });
+			if (Items_.empty())
+				return false;
+			for (std::size_t i = 0; i < Max && !Items_.empty(); ++i) {
+				Batch.push_back(std::move(Items_.front().second));
+				PopFront();
+			}
+			G.unlock();
+			NotFull_.notify_all();
+			return true;
+		}
+
+		//	True when TryPop would find nothing.
+		inline bool Empty() {
+			std::lock_guard G(Mutex_);
+			return Shutdown_ || Items_.empty();
+		}
+
+		void Shutdown() {
+			{
+				std::lock_guard G(Mutex_);
+				Shutdown_ = true;
+			}
+			NotEmpty_.notify_all();
+			NotFull_.notify_all();
+		}
+
+		inline std::size_t Size() {
+			std::lock_guard G(Mutex_);
+			return Items_.size();
+		}
+
+		inline uint64_t Dropped() const { return Dropped_; }
+		inline uint64_t Coalesced() const { return Coalesced_; }
+		inline uint64_t BlockedNs() const { return BlockedNs_; }
+
+		void GetStats(Poco::JSON::Object &Obj) {
+			Obj.set("queueDepth", Size());
+			Obj.set("capacity", Capacity_);
+			Obj.set("policy", OverloadPolicyToString(Policy_));
+			Obj.set("dropped", Dropped());
+			Obj.set("coalesced", Coalesced());
+			Obj.set("blockedNs", BlockedNs());
+		}
+
+	  private:
+		std::mutex Mutex_;
+		std::condition_variable NotEmpty_, NotFull_;
+		std::size_t Capacity_;
+		OverloadPolicy Policy_;
+		bool Shutdown_ = false;
+		std::list<std::pair<uint64_t, T>> Items_;
+		std::unordered_map<uint64_t, typename std::list<std::pair<uint64_t, T>>::iterator> Index_;
+		std::atomic_uint64_t Dropped_ = 0;
+		std::atomic_uint64_t Coalesced_ = 0;
+		std::atomic_uint64_t BlockedNs_ = 0;
+
+		inline void PopFront() {
+			if (Policy_ == OverloadPolicy::coalesce)
+				Index_.erase(Items_.front().first);
+			Items_.pop_front();
+		}
+	};
+
+} // namespace OpenWifi
@@ -29,8 +29,9 @@ namespace OpenWifi {
 		if (instance_ == nullptr) {
 			instance_ = new Daemon(vDAEMON_PROPERTIES_FILENAME, vDAEMON_ROOT_ENV_VAR,
 								   vDAEMON_CONFIG_ENV_VAR, vDAEMON_APP_NAME, vDAEMON_BUS_TIMER,
-								   SubSystemVec{OpenWifi::StorageService(), StateReceiver(),
-												DeviceStatusReceiver(), HealthReceiver(),
+								   SubSystemVec{OpenWifi::StorageService(),
+												StateReceiver(), DeviceStatusReceiver(),
+												HealthReceiver(),
 												VenueCoordinator(), WifiClientCache(),
 												UI_WebSocketClientServer()});
 		}
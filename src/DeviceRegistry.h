@@ -0,0 +1,146 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenWifi {
+
+	class VenueWatcher;
+
+	//	Serial number -> boards watching that device. Shared by the state, health and device
+	//	status receivers: the Kafka key is checked against it before any work is done, and the
+	//	parsed message is dispatched to the watchers it returns.
+	//
+	//	Lookups happen for every Kafka message while registrations only change when
+	//	VenueCoordinator reconciles boards, so the table is immutable once published. Readers
+	//	grab the current snapshot without locking; writers serialize on Mutex_, copy the table,
+	//	apply their change and publish the new version atomically.
+	class DeviceRegistry {
+	  public:
+		using WatcherList = std::vector<std::shared_ptr<VenueWatcher>>;
+		using Table = std::unordered_map<uint64_t, WatcherList>;
+
+		static auto instance() {
+			static auto instance_ = new DeviceRegistry;
+			return instance_;
+		}
+
+		inline void Register(const std::vector<uint64_t> &SerialNumbers,
+							 const std::shared_ptr<VenueWatcher> &VW) {
+			Update([&](Table &T) {
+				for (const auto &SerialNumber : SerialNumbers)
+					Add(T, SerialNumber, VW);
+			});
+		}
+
+		inline void DeRegister(const std::vector<uint64_t> &SerialNumbers, const VenueWatcher *VW) {
+			Update([&](Table &T) {
+				for (const auto &SerialNumber : SerialNumbers)
+					Remove(T, SerialNumber, VW);
+			});
+		}
+
+		//	Bulk update used when a board's device list changes: one new version for the whole diff.
+		inline void Modify(const std::vector<uint64_t> &ToRemove, const std::vector<uint64_t> &ToAdd,
+						   const std::shared_ptr<VenueWatcher> &VW) {
+			Update([&](Table &T) {
+				for (const auto &SerialNumber : ToRemove)
+					Remove(T, SerialNumber, VW.get());
+				for (const auto &SerialNumber : ToAdd)
+					Add(T, SerialNumber, VW);
+			});
+		}
+
+		inline std::shared_ptr<const Table> Snapshot() const { return std::atomic_load(&Table_); }
+
+		inline bool Watched(uint64_t SerialNumber) const {
+			auto T = Snapshot();
+			return T->find(SerialNumber) != T->end();
+		}
+
+		inline bool Watched(std::string_view Key) const {
+			uint64_t SerialNumber;
+			return KeyToSerialNumber(Key, SerialNumber) && Watched(SerialNumber);
+		}
+
+		//	Calls f(VenueWatcher *) for every board watching SerialNumber. The snapshot keeps the
+		//	watchers alive for the duration of the call, even if they are deregistered meanwhile.
+		template <typename F> inline void ForEach(uint64_t SerialNumber, F f) const {
+			auto T = Snapshot();
+			auto It = T->find(SerialNumber);
+			if (It == T->end())
+				return;
+			for (const auto &VW : It->second)
+				f(VW.get());
+		}
+
+		inline uint64_t Version() const { return Version_; }
+
+		//	Same result as Utils::SerialNumberToInt but without throwing on garbage keys.
+		static inline bool KeyToSerialNumber(std::string_view Key, uint64_t &SerialNumber) {
+			if (Key.empty() || Key.size() > 16)
+				return false;
+			SerialNumber = 0;
+			for (const auto &c : Key) {
+				SerialNumber <<= 4;
+				if (c >= '0' && c <= '9')
+					SerialNumber += (c - '0');
+				else if (c >= 'a' && c <= 'f')
+					SerialNumber += (c - 'a' + 10);
+				else if (c >= 'A' && c <= 'F')
+					SerialNumber += (c - 'A' + 10);
+				else
+					return false;
+			}
+			return true;
+		}
+
+	  private:
+		std::mutex Mutex_;
+		std::shared_ptr<const Table> Table_ = std::make_shared<const Table>();
+		std::atomic_uint64_t Version_ = 0;
+
+		template <typename F> inline void Update(F f) {
+			std::lock_guard G(Mutex_);
+			auto NewTable = std::make_shared<Table>(*Snapshot());
+			f(*NewTable);
+			std::atomic_store(&Table_, std::shared_ptr<const Table>(std::move(NewTable)));
+			Version_++;
+		}
+
+		static inline void Add(Table &T, uint64_t SerialNumber,
+							   const std::shared_ptr<VenueWatcher> &VW) {
+			auto &L = T[SerialNumber];
+			for (const auto &i : L)
+				if (i == VW)
+					return;
+			L.push_back(VW);
+		}
+
+		static inline void Remove(Table &T, uint64_t SerialNumber, const VenueWatcher *VW) {
+			auto It = T.find(SerialNumber);
+			if (It == T.end())
+				return;
+			auto &L = It->second;
+			L.erase(std::remove_if(L.begin(), L.end(),
+								   [VW](const auto &i) { return i.get() == VW; }),
+					L.end());
+			if (L.empty())
+				T.erase(It);
+		}
+	};
+
+	inline auto DeviceRegistry() { return DeviceRegistry::instance(); }
+
+} // namespace OpenWifi
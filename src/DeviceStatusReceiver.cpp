@@ -3,16 +3,20 @@
 //
 
 #include "DeviceStatusReceiver.h"
+#include "DeviceRegistry.h"
 #include "VenueWatcher.h"
 #include "fmt/core.h"
 #include "framework/KafkaManager.h"
 #include "framework/KafkaTopics.h"
+#include "framework/MicroServiceFuncs.h"
 
 namespace OpenWifi {
 	int DeviceStatusReceiver::Start() {
-		Running_ = true;
-		Types::TopicNotifyFunction F = [this](const std::string &Key, const std::string &Payload) {
-			this->DeviceStatusReceived(Key, Payload);
+		Queue_.Configure(MicroServiceConfigGetInt("devicestatus.receiver.queue.size", 10000),
+						 OverloadPolicyFromString(
+							 MicroServiceConfigGetString("devicestatus.receiver.queue.policy", "block")));
+		Types::TopicNotifyFunction F = [this](const Types::KafkaIncomingMessagePtr &Msg) {
+			this->DeviceStatusReceived(Msg);
 		};
 		DeviceStateWatcherId_ = KafkaManager()->RegisterTopicWatcher(KafkaTopics::CONNECTION, F);
 		Worker_.start(*this);
@@ -20,67 +24,51 @@ namespace OpenWifi {
 	}
 
 	void DeviceStatusReceiver::Stop() {
-		Running_ = false;
 		KafkaManager()->UnregisterTopicWatcher(KafkaTopics::CONNECTION, DeviceStateWatcherId_);
-		Queue_.wakeUpAll();
+		Queue_.Shutdown();
 		Worker_.join();
 	}
 
 	void DeviceStatusReceiver::run() {
 		Utils::SetThreadName("dev-status");
-		Poco::AutoPtr<Poco::Notification> Note(Queue_.waitDequeueNotification());
-		while (Note && Running_) {
-			auto Msg = dynamic_cast<DeviceStatusMessage *>(Note.get());
-			if (Msg != nullptr) {
-				try {
-					nlohmann::json msg = nlohmann::json::parse(Msg->Payload());
-					if (msg.contains(uCentralProtocol::PAYLOAD)) {
-						auto payload = msg[uCentralProtocol::PAYLOAD];
+		Types::KafkaIncomingMessagePtr Msg;
+		while (Queue_.Pop(Msg)) {
+			try {
+				auto Payload = Msg->Payload();
+				nlohmann::json msg = nlohmann::json::parse(Payload.begin(), Payload.end());
+				if (msg.contains(uCentralProtocol::PAYLOAD)) {
+					auto payload = msg[uCentralProtocol::PAYLOAD];
 
-						uint64_t SerialNumber = Utils::SerialNumberToInt(Msg->Key());
-						std::lock_guard G(Mutex_);
-
-						for (const auto &[venue, devices] : Notifiers_) {
-							if (devices.find(SerialNumber) != cend(devices)) {
-								auto connection_data = std::make_shared<nlohmann::json>(payload);
-								venue->PostConnection(SerialNumber, connection_data);
-								break;
-							}
-						}
+					uint64_t SerialNumber;
+					if (DeviceRegistry::KeyToSerialNumber(Msg->Key(), SerialNumber)) {
+						auto connection_data = std::make_shared<nlohmann::json>(payload);
+						DeviceRegistry()->ForEach(SerialNumber, [&](VenueWatcher *VW) {
+							VW->PostConnection(SerialNumber, connection_data);
+						});
 					}
-				} catch (const Poco::Exception &E) {
-					Logger().log(E);
-				} catch (...) {
 				}
-			} else {
+			} catch (const Poco::Exception &E) {
+				Logger().log(E);
+			} catch (...) {
 			}
-			Note = Queue_.waitDequeueNotification();
+			Msg.reset();
 		}
 	}
 
-	void DeviceStatusReceiver::Register(const std::vector<uint64_t> &SerialNumber,
-										VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-
-		std::set<uint64_t> NewSerialNumbers;
-		std::copy(SerialNumber.begin(), SerialNumber.end(),
-				  std::inserter(NewSerialNumbers, NewSerialNumbers.begin()));
-		auto it = Notifiers_.find(VW);
-		if (it == end(Notifiers_))
-			Notifiers_[VW] = NewSerialNumbers;
-		else
-			it->second = NewSerialNumbers;
-	}
-
-	void DeviceStatusReceiver::DeRegister(VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-		Notifiers_.erase(VW);
+	void DeviceStatusReceiver::DeviceStatusReceived(const Types::KafkaIncomingMessagePtr &Msg) {
+		auto Key = Msg->Key();
+		uint64_t SerialNumber;
+		if (!DeviceRegistry::KeyToSerialNumber(Key, SerialNumber) ||
+			!DeviceRegistry()->Watched(SerialNumber)) {
+			Filtered_++;
+			return;
+		}
+		poco_trace(Logger(), fmt::format("Device({}): Connection/Ping message.", Key));
+		Queue_.Push(SerialNumber, Types::KafkaIncomingMessagePtr(Msg));
 	}
 
-	void DeviceStatusReceiver::DeviceStatusReceived(const std::string &Key,
-													const std::string &Payload) {
-		std::lock_guard G(Mutex_);
-		poco_trace(Logger(), fmt::format("Device({}): Connection/Ping message.", Key));
-		Queue_.enqueueNotification(new DeviceStatusMessage(Key, Payload));
+	void DeviceStatusReceiver::GetStats(Poco::JSON::Object &Obj) {
+		Queue_.GetStats(Obj);
+		Obj.set("filtered", Filtered_.load());
 	}
 } // namespace OpenWifi
\ No newline at end of file
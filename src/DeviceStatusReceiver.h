@@ -4,23 +4,12 @@
 
 #pragma once
 
-#include "Poco/Notification.h"
-#include "Poco/NotificationQueue.h"
+#include "BoundedQueue.h"
+#include "Poco/JSON/Object.h"
+#include "framework/KafkaManager.h"
 #include "framework/SubSystemServer.h"
 
 namespace OpenWifi {
-	class DeviceStatusMessage : public Poco::Notification {
-	  public:
-		explicit DeviceStatusMessage(const std::string &Key, const std::string &Payload)
-			: Key_(Key), Payload_(Payload) {}
-		const std::string &Key() { return Key_; }
-		const std::string &Payload() { return Payload_; }
-
-	  private:
-		std::string Key_;
-		std::string Payload_;
-	};
-
 	class VenueWatcher;
 
 	class DeviceStatusReceiver : public SubSystemServer, Poco::Runnable {
@@ -33,17 +22,14 @@ namespace OpenWifi {
 		int Start() override;
 		void Stop() override;
 		void run() override;
-		void DeviceStatusReceived(const std::string &Key, const std::string &Payload);
-		void Register(const std::vector<uint64_t> &SerialNumber, VenueWatcher *VW);
-		void DeRegister(VenueWatcher *VW);
+		void DeviceStatusReceived(const Types::KafkaIncomingMessagePtr &Msg);
+		void GetStats(Poco::JSON::Object &Obj);
 
 	  private:
-		// map of mac(as int), list of (id,func)
-		std::map<VenueWatcher *, std::set<uint64_t>> Notifiers_;
 		uint64_t DeviceStateWatcherId_ = 0;
-		Poco::NotificationQueue Queue_;
+		BoundedQueue<Types::KafkaIncomingMessagePtr> Queue_;
 		Poco::Thread Worker_;
-		std::atomic_bool Running_ = false;
+		std::atomic_uint64_t Filtered_ = 0;
 
 		DeviceStatusReceiver() noexcept
 			: SubSystemServer("DeviceStatus", "DEV-STATUS-RECEIVER", "devicestatus.receiver") {}
@@ -0,0 +1,108 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "Executor.h"
+#include "fmt/core.h"
+#include "framework/utils.h"
+
+namespace OpenWifi {
+
+	void Executor::Start(uint64_t NumberOfThreads) {
+		if (NumberOfThreads < 1)
+			NumberOfThreads = 1;
+		Running_ = true;
+		for (uint64_t i = 0; i < NumberOfThreads; ++i)
+			Workers_.push_back(std::make_unique<Worker>(*this, i));
+		for (auto &W : Workers_)
+			W->Thread_.start(*W);
+	}
+
+	void Executor::Stop() {
+		if (!Running_)
+			return;
+		{
+			std::lock_guard G(IdleMutex_);
+			Running_ = false;
+		}
+		Idle_.notify_all();
+		for (auto &W : Workers_)
+			W->Thread_.join();
+		Workers_.clear();
+		Pending_ = 0;
+	}
+
+	void Executor::Submit(Task T) {
+		if (!Running_ || Workers_.empty())
+			return;
+		//	Counted before it is queued: a worker can take the task as soon as it is pushed, and
+		//	Pending_ must never drop below the number of queued tasks.
+		{
+			std::lock_guard G(IdleMutex_);
+			Pending_++;
+		}
+		if (CurrentWorker_ != nullptr && &CurrentWorker_->Executor_ == this)
+			CurrentWorker_->Push(std::move(T));
+		else
+			Workers_[NextWorker_++ % Workers_.size()]->Push(std::move(T));
+		Idle_.notify_one();
+	}
+
+	bool Executor::Next(Worker &W, Task &T) {
+		if (W.Pop(T))
+			return true;
+		for (uint64_t i = 1; i < Workers_.size(); ++i) {
+			auto &Victim = *Workers_[(W.Id_ + i) % Workers_.size()];
+			if (Victim.Steal(T)) {
+				W.Stolen_++;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Executor::Worker::run() {
+		Utils::SetThreadName(fmt::format("{}-{}", Executor_.Name_, Id_).c_str());
+		CurrentWorker_ = this;
+		while (true) {
+			{
+				std::unique_lock G(Executor_.IdleMutex_);
+				Executor_.Idle_.wait(
+					G, [this] { return !Executor_.Running_ || Executor_.Pending_ > 0; });
+				if (!Executor_.Running_)
+					break;
+			}
+
+			Task T;
+			if (!Executor_.Next(*this, T))
+				continue;
+			Executor_.Pending_--;
+			try {
+				T->run();
+			} catch (...) {
+			}
+			Executed_++;
+		}
+		CurrentWorker_ = nullptr;
+	}
+
+	void Executor::GetStats(Poco::JSON::Object &Obj) {
+		Poco::JSON::Array ThreadArray;
+		uint64_t Executed = 0, Stolen = 0;
+		for (const auto &W : Workers_) {
+			Poco::JSON::Object ThreadObj;
+			ThreadObj.set("thread", W->Id_);
+			ThreadObj.set("executed", W->Executed_.load());
+			ThreadObj.set("stolen", W->Stolen_.load());
+			Executed += W->Executed_;
+			Stolen += W->Stolen_;
+			ThreadArray.add(ThreadObj);
+		}
+		Obj.set("threads", Workers_.size());
+		Obj.set("pending", Pending_.load());
+		Obj.set("executed", Executed);
+		Obj.set("stolen", Stolen);
+		Obj.set("perThread", ThreadArray);
+	}
+
+} // namespace OpenWifi
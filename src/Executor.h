@@ -0,0 +1,90 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/JSON/Object.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	A fixed pool of threads running short tasks. Each thread has its own run queue: a task
+	//	submitted from a pool thread goes to that thread's queue, any other submission is spread
+	//	round-robin. An idle thread steals from the others before going to sleep.
+	//
+	//	Tasks are expected to do a bounded amount of work and resubmit themselves if they have
+	//	more, so a busy task cannot hold a thread while others wait.
+	class Executor {
+	  public:
+		using Task = std::shared_ptr<Poco::Runnable>;
+
+		explicit Executor(const std::string &Name) : Name_(Name) {}
+		~Executor() { Stop(); }
+
+		void Start(uint64_t NumberOfThreads);
+		void Stop();
+		void Submit(Task T);
+		void GetStats(Poco::JSON::Object &Obj);
+		inline uint64_t Threads() const { return Workers_.size(); }
+
+	  private:
+		class Worker : public Poco::Runnable {
+		  public:
+			Worker(Executor &E, uint64_t Id) : Executor_(E), Id_(Id) {}
+			void run() override;
+
+			inline void Push(Task T) {
+				std::lock_guard G(Mutex_);
+				Tasks_.push_back(std::move(T));
+			}
+
+			inline bool Pop(Task &T) {
+				std::lock_guard G(Mutex_);
+				if (Tasks_.empty())
+					return false;
+				T = std::move(Tasks_.front());
+				Tasks_.pop_front();
+				return true;
+			}
+
+			//	Thieves take from the other end, away from the owner.
+			inline bool Steal(Task &T) {
+				std::lock_guard G(Mutex_);
+				if (Tasks_.empty())
+					return false;
+				T = std::move(Tasks_.back());
+				Tasks_.pop_back();
+				return true;
+			}
+
+			Executor &Executor_;
+			uint64_t Id_ = 0;
+			std::mutex Mutex_;
+			std::deque<Task> Tasks_;
+			Poco::Thread Thread_;
+			std::atomic_uint64_t Executed_ = 0;
+			std::atomic_uint64_t Stolen_ = 0;
+		};
+
+		std::string Name_;
+		std::vector<std::unique_ptr<Worker>> Workers_;
+		std::mutex IdleMutex_;
+		std::condition_variable Idle_;
+		std::atomic_uint64_t Pending_ = 0;
+		std::atomic_uint64_t NextWorker_ = 0;
+		std::atomic_bool Running_ = false;
+		static inline thread_local Worker *CurrentWorker_ = nullptr;
+
+		bool Next(Worker &W, Task &T);
+	};
+
+} // namespace OpenWifi
@@ -3,16 +3,20 @@
 //
 
 #include "HealthReceiver.h"
+#include "DeviceRegistry.h"
 #include "VenueWatcher.h"
 #include "fmt/core.h"
 #include "framework/KafkaManager.h"
 #include "framework/KafkaTopics.h"
+#include "framework/MicroServiceFuncs.h"
 
 namespace OpenWifi {
 	int HealthReceiver::Start() {
-		Running_ = true;
-		Types::TopicNotifyFunction F = [this](const std::string &Key, const std::string &Payload) {
-			this->HealthReceived(Key, Payload);
+		Queue_.Configure(MicroServiceConfigGetInt("health.receiver.queue.size", 10000),
+						 OverloadPolicyFromString(
+							 MicroServiceConfigGetString("health.receiver.queue.policy", "block")));
+		Types::TopicNotifyFunction F = [this](const Types::KafkaIncomingMessagePtr &Msg) {
+			this->HealthReceived(Msg);
 		};
 		HealthWatcherId_ = KafkaManager()->RegisterTopicWatcher(KafkaTopics::HEALTHCHECK, F);
 		Worker_.start(*this);
@@ -20,65 +24,51 @@ namespace OpenWifi {
 	}
 
 	void HealthReceiver::Stop() {
-		Running_ = false;
 		KafkaManager()->UnregisterTopicWatcher(KafkaTopics::HEALTHCHECK, HealthWatcherId_);
-		Queue_.wakeUpAll();
+		Queue_.Shutdown();
 		Worker_.join();
 	}
 
 	void HealthReceiver::run() {
 		Utils::SetThreadName("dev-health");
-		Poco::AutoPtr<Poco::Notification> Note(Queue_.waitDequeueNotification());
-		while (Note && Running_) {
-			auto Msg = dynamic_cast<HealthMessage *>(Note.get());
-			if (Msg != nullptr) {
-				try {
-					nlohmann::json msg = nlohmann::json::parse(Msg->Payload());
-					if (msg.contains(uCentralProtocol::PAYLOAD)) {
-						auto payload = msg[uCentralProtocol::PAYLOAD];
+		Types::KafkaIncomingMessagePtr Msg;
+		while (Queue_.Pop(Msg)) {
+			try {
+				auto Payload = Msg->Payload();
+				nlohmann::json msg = nlohmann::json::parse(Payload.begin(), Payload.end());
+				if (msg.contains(uCentralProtocol::PAYLOAD)) {
+					auto payload = msg[uCentralProtocol::PAYLOAD];
 
-						uint64_t SerialNumber = Utils::SerialNumberToInt(Msg->Key());
-						std::lock_guard G(Mutex_);
-
-						for (const auto &[venue, devices] : Notifiers_) {
-							if (devices.find(SerialNumber) != cend(devices)) {
-								auto health_data = std::make_shared<nlohmann::json>(payload);
-								venue->PostHealth(SerialNumber, health_data);
-								break;
-							}
-						}
+					uint64_t SerialNumber;
+					if (DeviceRegistry::KeyToSerialNumber(Msg->Key(), SerialNumber)) {
+						auto health_data = std::make_shared<nlohmann::json>(payload);
+						DeviceRegistry()->ForEach(SerialNumber, [&](VenueWatcher *VW) {
+							VW->PostHealth(SerialNumber, health_data);
+						});
 					}
-				} catch (const Poco::Exception &E) {
-					Logger().log(E);
-				} catch (...) {
 				}
-			} else {
+			} catch (const Poco::Exception &E) {
+				Logger().log(E);
+			} catch (...) {
 			}
-			Note = Queue_.waitDequeueNotification();
+			Msg.reset();
 		}
 	}
 
-	void HealthReceiver::Register(const std::vector<uint64_t> &SerialNumber, VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-
-		std::set<uint64_t> NewSerialNumbers;
-		std::copy(SerialNumber.begin(), SerialNumber.end(),
-				  std::inserter(NewSerialNumbers, NewSerialNumbers.begin()));
-		auto it = Notifiers_.find(VW);
-		if (it == end(Notifiers_))
-			Notifiers_[VW] = NewSerialNumbers;
-		else
-			it->second = NewSerialNumbers;
-	}
-
-	void HealthReceiver::DeRegister(VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-		Notifiers_.erase(VW);
+	void HealthReceiver::HealthReceived(const Types::KafkaIncomingMessagePtr &Msg) {
+		auto Key = Msg->Key();
+		uint64_t SerialNumber;
+		if (!DeviceRegistry::KeyToSerialNumber(Key, SerialNumber) ||
+			!DeviceRegistry()->Watched(SerialNumber)) {
+			Filtered_++;
+			return;
+		}
+		poco_trace(Logger(), fmt::format("Device({}): Health message.", Key));
+		Queue_.Push(SerialNumber, Types::KafkaIncomingMessagePtr(Msg));
 	}
 
-	void HealthReceiver::HealthReceived(const std::string &Key, const std::string &Payload) {
-		std::lock_guard G(Mutex_);
-		poco_trace(Logger(), fmt::format("Device({}): Health message.", Key));
-		Queue_.enqueueNotification(new HealthMessage(Key, Payload));
+	void HealthReceiver::GetStats(Poco::JSON::Object &Obj) {
+		Queue_.GetStats(Obj);
+		Obj.set("filtered", Filtered_.load());
 	}
 } // namespace OpenWifi
\ No newline at end of file
@@ -0,0 +1,89 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace OpenWifi {
+
+	//	A 48-bit MAC kept as an integer. Devices report MACs as text, in several spellings; they
+	//	are parsed once on the way in and only turned back into text for the REST API and the
+	//	database. A default constructed (or unparsable) MAC is empty and prints as "".
+	class MACAddress {
+	  public:
+		MACAddress() = default;
+		explicit constexpr MACAddress(uint64_t Value) : Value_(Value & 0xffffffffffffULL) {}
+
+		//	Accepts 12 hex digits, optionally separated by ':', '-' or '.'.
+		static inline bool Parse(std::string_view S, MACAddress &M) {
+			uint64_t Value = 0;
+			int Digits = 0;
+			for (const auto &c : S) {
+				if (c == ':' || c == '-' || c == '.')
+					continue;
+				uint64_t Nibble;
+				if (c >= '0' && c <= '9')
+					Nibble = c - '0';
+				else if (c >= 'a' && c <= 'f')
+					Nibble = c - 'a' + 10;
+				else if (c >= 'A' && c <= 'F')
+					Nibble = c - 'A' + 10;
+				else
+					return false;
+				if (++Digits > 12)
+					return false;
+				Value = (Value << 4) | Nibble;
+			}
+			if (Digits != 12)
+				return false;
+			M.Value_ = Value;
+			return true;
+		}
+
+		static inline MACAddress FromString(std::string_view S) {
+			MACAddress M;
+			Parse(S, M);
+			return M;
+		}
+
+		//	"aa:bb:cc:dd:ee:ff", or "aabbccddeeff" when Separator is 0.
+		[[nodiscard]] inline std::string ToString(char Separator = ':') const {
+			if (Value_ == 0)
+				return {};
+			static const char Hex[] = "0123456789abcdef";
+			std::string R;
+			R.reserve(17);
+			for (int i = 5; i >= 0; --i) {
+				auto Byte = (Value_ >> (i * 8)) & 0xff;
+				R += Hex[Byte >> 4];
+				R += Hex[Byte & 0xf];
+				if (i && Separator)
+					R += Separator;
+			}
+			return R;
+		}
+
+		[[nodiscard]] inline std::string ToHex() const { return ToString(0); }
+		[[nodiscard]] inline uint64_t Value() const { return Value_; }
+		[[nodiscard]] inline bool Empty() const { return Value_ == 0; }
+
+		inline bool operator==(const MACAddress &R) const { return Value_ == R.Value_; }
+		inline bool operator!=(const MACAddress &R) const { return Value_ != R.Value_; }
+		inline bool operator<(const MACAddress &R) const { return Value_ < R.Value_; }
+
+	  private:
+		uint64_t Value_ = 0;
+	};
+
+} // namespace OpenWifi
+
+template <> struct std::hash<OpenWifi::MACAddress> {
+	std::size_t operator()(const OpenWifi::MACAddress &M) const noexcept {
+		return std::hash<uint64_t>{}(M.Value());
+	}
+};
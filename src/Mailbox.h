@@ -0,0 +1,246 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "BoundedQueue.h"
+#include "Poco/JSON/Object.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace OpenWifi {
+
+	template <typename T> struct MailboxNode {
+		std::atomic<MailboxNode *> next{nullptr};
+		uint64_t posted = 0;
+		T item;
+	};
+
+	//	Nodes are recycled instead of going back to the heap. The consumer gives nodes back one at
+	//	a time; a producer whose local cache is empty takes the whole shared list at once. Since
+	//	nothing ever pops a single node off the shared list, there is no ABA problem.
+	template <typename T> class MailboxNodePool {
+	  public:
+		using Node = MailboxNode<T>;
+
+		static MailboxNodePool &instance() {
+			static auto instance_ = new MailboxNodePool;
+			return *instance_;
+		}
+
+		inline Node *Get() {
+			auto &Cache = Cache_;
+			if (Cache == nullptr)
+				Cache = Free_.exchange(nullptr, std::memory_order_acquire);
+			if (Cache == nullptr) {
+				Allocated_++;
+				return new Node;
+			}
+			auto N = Cache;
+			Cache = N->next.load(std::memory_order_relaxed);
+			N->next.store(nullptr, std::memory_order_relaxed);
+			Reused_++;
+			return N;
+		}
+
+		inline void Release(Node *N) {
+			N->item = T();
+			auto Head = Free_.load(std::memory_order_relaxed);
+			do {
+				N->next.store(Head, std::memory_order_relaxed);
+			} while (!Free_.compare_exchange_weak(Head, N, std::memory_order_release,
+												  std::memory_order_relaxed));
+		}
+
+		inline uint64_t Allocated() const { return Allocated_; }
+		inline uint64_t Reused() const { return Reused_; }
+
+	  private:
+		std::atomic<Node *> Free_{nullptr};
+		std::atomic_uint64_t Allocated_ = 0;
+		std::atomic_uint64_t Reused_ = 0;
+		static inline thread_local Node *Cache_ = nullptr;
+	};
+
+	//	Multi-producer, single-consumer queue (D. Vyukov's intrusive design): posting is one
+	//	atomic exchange, no lock is ever taken. Only one thread at a time may call TryPop.
+	//
+	//	Only the consumer can remove items, so the overload policies work differently than in
+	//	BoundedQueue: block makes the producer wait for room, drop_oldest and coalesce let the
+	//	producer through and the consumer discards the oldest items above capacity. A blocked
+	//	producer sleeps on a condition variable, which the consumer signals after taking an item;
+	//	the lock is only taken when a producer is waiting.
+	template <typename T> class Mailbox {
+	  public:
+		using Node = MailboxNode<T>;
+
+		explicit Mailbox(std::size_t Capacity = 1000, OverloadPolicy Policy = OverloadPolicy::block)
+			: Capacity_(Capacity ? Capacity : 1), Policy_(Policy), Head_(&Stub_), Tail_(&Stub_) {}
+
+		~Mailbox() {
+			Shutdown();
+			Node *N;
+			while ((N = Take()) != nullptr)
+				Pool().Release(N);
+		}
+
+		Mailbox(const Mailbox &) = delete;
+		Mailbox &operator=(const Mailbox &) = delete;
+
+		//	Must be called before any producer or consumer touches the mailbox.
+		inline void Configure(std::size_t Capacity, OverloadPolicy Policy) {
+			Capacity_ = Capacity ? Capacity : 1;
+			Policy_ = Policy;
+			Shutdown_ = false;
+		}
+
+		//	Returns false if the mailbox was shut down.
+		bool Push(T &&Item) {
+			if (Shutdown_)
+				return false;
+			if (Policy_ == OverloadPolicy::block && Size_ >= Capacity_) {
+				auto Start = std::chrono::steady_clock::now();
+				//	Counted before Size_ is checked again, so that either this producer sees the
+				//	room made by a pop, or that pop sees it waiting and signals it.
+				Waiters_++;
+				{
+					std::unique_lock G(WaitMutex_);
+					NotFull_.wait(G, [this] { return Shutdown_ || Size_ < Capacity_; });
+				}
+				Waiters_--;
+				BlockedNs_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+								  std::chrono::steady_clock::now() - Start)
+								  .count();
+				if (Shutdown_)
+					return false;
+			}
+
+			auto N = Pool().Get();
+			N->item = std::move(Item);
+			N->posted = Now();
+			//	Counted before it is linked so that Empty() never misses an item being pushed.
+			Size_++;
+			Link(N);
+			return true;
+		}
+
+		//	Never waits. Returns false when there is nothing to consume yet or after shutdown.
+		bool TryPop(T &Item) {
+			if (Shutdown_)
+				return false;
+			if (Policy_ != OverloadPolicy::block) {
+				while (Size_ > Capacity_) {
+					auto N = Take();
+					if (N == nullptr)
+						break;
+					Dropped_++;
+					Pool().Release(N);
+				}
+			}
+			auto N = Take();
+			if (N == nullptr)
+				return false;
+			if (Waiters_) {
+				std::lock_guard G(WaitMutex_);
+				NotFull_.notify_one();
+			}
+			auto Latency = Now() - N->posted;
+			LatencyNs_ += Latency;
+			if (Latency > MaxLatencyNs_)
+				MaxLatencyNs_ = Latency;
+			Consumed_++;
+			Item = std::move(N->item);
+			Pool().Release(N);
+			return true;
+		}
+
+		//	True when TryPop would find nothing.
+		inline bool Empty() const { return Shutdown_ || Size_ == 0; }
+
+		void Shutdown() {
+			Shutdown_ = true;
+			std::lock_guard G(WaitMutex_);
+			NotFull_.notify_all();
+		}
+
+		inline std::size_t Size() const { return Size_; }
+		inline uint64_t Dropped() const { return Dropped_; }
+		inline uint64_t BlockedNs() const { return BlockedNs_; }
+
+		void GetStats(Poco::JSON::Object &Obj) {
+			Obj.set("queueDepth", Size());
+			Obj.set("capacity", Capacity_);
+			Obj.set("policy", OverloadPolicyToString(Policy_));
+			Obj.set("dropped", Dropped());
+			Obj.set("blockedNs", BlockedNs());
+			Obj.set("consumed", Consumed_.load());
+			Obj.set("latencyNs", LatencyNs_.load());
+			Obj.set("maxLatencyNs", MaxLatencyNs_.load());
+		}
+
+		static inline MailboxNodePool<T> &Pool() { return MailboxNodePool<T>::instance(); }
+
+	  private:
+		std::size_t Capacity_;
+		OverloadPolicy Policy_;
+		std::atomic_bool Shutdown_ = false;
+		std::atomic_size_t Size_ = 0;
+		std::atomic_uint64_t Waiters_ = 0;
+		std::mutex WaitMutex_;
+		std::condition_variable NotFull_;
+		Node Stub_;
+		std::atomic<Node *> Head_;
+		Node *Tail_;
+		std::atomic_uint64_t Dropped_ = 0;
+		std::atomic_uint64_t BlockedNs_ = 0;
+		std::atomic_uint64_t Consumed_ = 0;
+		//	Only written by the consumer.
+		std::atomic_uint64_t LatencyNs_ = 0;
+		std::atomic_uint64_t MaxLatencyNs_ = 0;
+
+		static inline uint64_t Now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					   std::chrono::steady_clock::now().time_since_epoch())
+				.count();
+		}
+
+		inline void Link(Node *N) {
+			N->next.store(nullptr, std::memory_order_relaxed);
+			auto Prev = Head_.exchange(N, std::memory_order_acq_rel);
+			Prev->next.store(N, std::memory_order_release);
+		}
+
+		//	Unlinks the oldest node. Returns nullptr if the mailbox is empty or if the oldest
+		//	producer has not finished linking its node: that producer will reschedule the consumer.
+		Node *Take() {
+			auto Tail = Tail_;
+			auto Next = Tail->next.load(std::memory_order_acquire);
+			if (Tail == &Stub_) {
+				if (Next == nullptr)
+					return nullptr;
+				Tail_ = Next;
+				Tail = Next;
+				Next = Next->next.load(std::memory_order_acquire);
+			}
+			if (Next != nullptr) {
+				Tail_ = Next;
+				Size_--;
+				return Tail;
+			}
+			if (Tail != Head_.load(std::memory_order_acquire))
+				return nullptr;
+			Link(&Stub_);
+			Next = Tail->next.load(std::memory_order_acquire);
+			if (Next != nullptr) {
+				Tail_ = Next;
+				Size_--;
+				return Tail;
+			}
+			return nullptr;
+		}
+	};
+
+} // namespace OpenWifi
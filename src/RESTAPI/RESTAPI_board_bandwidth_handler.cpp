@@ -0,0 +1,34 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "RESTAPI_board_bandwidth_handler.h"
+#include "StorageService.h"
+#include "VenueCoordinator.h"
+
+namespace OpenWifi {
+	void RESTAPI_board_bandwidth_handler::DoGet() {
+		auto id = GetBinding("id", "");
+		if (id.empty() || !Utils::ValidUUID(id)) {
+			return BadRequest(RESTAPI::Errors::MissingUUID);
+		}
+
+		AnalyticsObjects::BoardInfo B;
+		if (!StorageService()->BoardsDB().GetRecord("id", id, B)) {
+			return NotFound();
+		}
+
+		auto endDate = GetParameter("endDate", Utils::Now());
+		auto fromDate = GetParameter("fromDate", endDate > 3600 ? endDate - 3600 : 0);
+		auto interval = GetParameter("interval", 0);
+
+		AnalyticsObjects::BandwidthAnalysis BW;
+		if (!VenueCoordinator()->GetBandwidth(id, fromDate, endDate, interval, BW)) {
+			return NotFound();
+		}
+
+		Poco::JSON::Object Answer;
+		BW.to_json(Answer);
+		return ReturnObject(Answer);
+	}
+} // namespace OpenWifi
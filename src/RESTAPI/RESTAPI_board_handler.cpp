@@ -32,9 +32,10 @@ namespace OpenWifi {
 		if (!StorageService()->BoardsDB().GetRecord("id", id, B)) {
 			return NotFound();
 		}
-		VenueCoordinator()->StopBoard(id);
+		VenueCoordinator()->StopBoard(id, true);
 		StorageService()->BoardsDB().DeleteRecord("id", id);
 		StorageService()->TimePointsDB().DeleteBoard(id);
+		StorageService()->BoardStatsDB().DeleteBoard(id);
 		return OK();
 	}
 
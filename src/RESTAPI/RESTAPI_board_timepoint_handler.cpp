@@ -4,6 +4,7 @@
 
 #include "RESTAPI_board_timepoint_handler.h"
 #include "StorageService.h"
+#include "VenueCoordinator.h"
 
 #include <algorithm>
 
@@ -162,10 +163,22 @@ namespace OpenWifi {
 			return ReturnObject(Answer);
 		}
 
+		//	Ranges stored before the board had aggregates fall through to the points themselves.
+		if (pointsStatsOnly) {
+			std::vector<AnalyticsObjects::DeviceTimePointAnalysis> Stats;
+			if (VenueCoordinator()->GetBoardStats(id, fromDate, endDate, maxRecords, Stats)) {
+				Poco::JSON::Object Answer;
+				RESTAPI_utils::field_to_json(Answer, "stats", Stats);
+				return ReturnObject(Answer);
+			}
+		}
+
 		AnalyticsObjects::DeviceTimePointList Points;
 		auto LatestPerDevice = GetBoolParameter("LatestPerDevice", false);
-		StorageService()->TimePointsDB().SelectRecords(id, fromDate, endDate, maxRecords, LatestPerDevice,
-													   Points.points);
+		if (!VenueCoordinator()->GetTimePoints(id, fromDate, endDate, maxRecords, LatestPerDevice,
+											   Points.points))
+			StorageService()->TimePointsDB().SelectRecords(id, fromDate, endDate, maxRecords,
+														   LatestPerDevice, Points.points);
 		std::cout << "1 MaxRecords=" << maxRecords << " retrieved=" << Points.points.size()
 				  << std::endl;
 
@@ -255,6 +268,8 @@ namespace OpenWifi {
 		auto endDate = GetParameter("endDate", 0);
 
 		StorageService()->TimePointsDB().DeleteTimeLine(id, fromDate, endDate);
+		StorageService()->BoardStatsDB().DeleteTimeLine(id, fromDate, endDate);
+		VenueCoordinator()->ClearTimePoints(id);
 		return OK();
 	}
 
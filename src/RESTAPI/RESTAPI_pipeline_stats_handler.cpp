@@ -0,0 +1,52 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "RESTAPI_pipeline_stats_handler.h"
+#include "DeviceStatusReceiver.h"
+#include "HealthReceiver.h"
+#include "StateReceiver.h"
+#include "StorageService.h"
+#include "StringDictionary.h"
+#include "VenueCoordinator.h"
+#include "framework/KafkaManager.h"
+
+namespace OpenWifi {
+	void RESTAPI_pipeline_stats_handler::DoGet() {
+		Poco::JSON::Object Answer;
+
+		Poco::JSON::Object State;
+		StateReceiver()->GetStats(State);
+		Answer.set("state", State);
+
+		Poco::JSON::Object Health;
+		HealthReceiver()->GetStats(Health);
+		Answer.set("health", Health);
+
+		Poco::JSON::Object Status;
+		DeviceStatusReceiver()->GetStats(Status);
+		Answer.set("status", Status);
+
+		Poco::JSON::Object Boards;
+		VenueCoordinator()->GetStats(Boards);
+		Answer.set("boards", Boards);
+
+		Poco::JSON::Object SSIDs;
+		SSIDDictionary()->GetStats(SSIDs);
+		Answer.set("ssids", SSIDs);
+
+		Poco::JSON::Object Writers;
+		StorageService()->GetWriterStats(Writers);
+		Answer.set("writers", Writers);
+
+		Poco::JSON::Object Storage;
+		StorageService()->GetIngestStats(Storage);
+		Answer.set("storage", Storage);
+
+		Poco::JSON::Array Consumers;
+		KafkaManager()->GetConsumerStats(Consumers);
+		Answer.set("consumers", Consumers);
+
+		return ReturnObject(Answer);
+	}
+} // namespace OpenWifi
@@ -2,10 +2,12 @@
 // Created by stephane bourque on 2021-10-23.
 //
 
+#include "RESTAPI/RESTAPI_board_bandwidth_handler.h"
 #include "RESTAPI/RESTAPI_board_devices_handler.h"
 #include "RESTAPI/RESTAPI_board_handler.h"
 #include "RESTAPI/RESTAPI_board_list_handler.h"
 #include "RESTAPI/RESTAPI_board_timepoint_handler.h"
+#include "RESTAPI/RESTAPI_pipeline_stats_handler.h"
 #include "RESTAPI/RESTAPI_wificlienthistory_handler.h"
 
 #include "framework/RESTAPI_SystemCommand.h"
@@ -20,7 +22,7 @@ namespace OpenWifi {
 		return RESTAPI_Router<RESTAPI_system_command, RESTAPI_system_configuration, RESTAPI_board_devices_handler,
 							  RESTAPI_board_timepoint_handler, RESTAPI_board_handler,
 							  RESTAPI_board_list_handler, RESTAPI_wificlienthistory_handler,
-							  RESTAPI_webSocketServer>(Path, Bindings, L, S, TransactionId);
+							  RESTAPI_pipeline_stats_handler, RESTAPI_board_bandwidth_handler, RESTAPI_webSocketServer>(Path, Bindings, L, S, TransactionId);
 	}
 
 	Poco::Net::HTTPRequestHandler *
@@ -28,7 +30,8 @@ namespace OpenWifi {
 					  Poco::Logger &L, RESTAPI_GenericServerAccounting &S, uint64_t TransactionId) {
 		return RESTAPI_Router_I<RESTAPI_system_command, RESTAPI_system_configuration, RESTAPI_board_devices_handler,
 								RESTAPI_board_timepoint_handler, RESTAPI_board_handler,
-								RESTAPI_board_list_handler, RESTAPI_wificlienthistory_handler>(
+								RESTAPI_board_list_handler, RESTAPI_wificlienthistory_handler,
+								RESTAPI_pipeline_stats_handler, RESTAPI_board_bandwidth_handler>(
 			Path, Bindings, L, S, TransactionId);
 	}
 
@@ -14,6 +14,27 @@ using OpenWifi::RESTAPI_utils::field_to_json;
 
 namespace OpenWifi::AnalyticsObjects {
 
+	//	MACs are binary in memory: this is where they become text again. Time points use the
+	//	"aa:bb:cc:dd:ee:ff" form the devices report, client history the bare hex digits.
+	static void mac_to_json(Poco::JSON::Object &Obj, const char *Field, const MACAddress &M,
+							char Separator) {
+		field_to_json(Obj, Field, M.ToString(Separator));
+	}
+
+	static void mac_from_json(const Poco::JSON::Object::Ptr &Obj, const char *Field,
+							  MACAddress &M) {
+		std::string S;
+		field_from_json(Obj, Field, S);
+		M = MACAddress::FromString(S);
+	}
+
+	static void ssid_from_json(const Poco::JSON::Object::Ptr &Obj, const char *Field,
+							   SSIDName &N) {
+		std::string S;
+		field_from_json(Obj, Field, S);
+		N = SSIDName(S);
+	}
+
 	void Report::reset() {}
 
 	void Report::to_json([[maybe_unused]] Poco::JSON::Object &Obj) const {}
@@ -172,7 +193,7 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 }
 
 	void UETimePoint::to_json(Poco::JSON::Object &Obj) const {
-		field_to_json(Obj, "station", station);
+		mac_to_json(Obj, "station", station, ':');
 		field_to_json(Obj, "rssi", rssi);
 		field_to_json(Obj, "tx_bytes", tx_bytes);
 		field_to_json(Obj, "rx_bytes", rx_bytes);
@@ -207,7 +228,7 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 
 	bool UETimePoint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 		try {
-			field_from_json(Obj, "station", station);
+			mac_from_json(Obj, "station", station);
 			field_from_json(Obj, "rssi", rssi);
 			field_from_json(Obj, "tx_bytes", tx_bytes);
 			field_from_json(Obj, "rx_bytes", rx_bytes);
@@ -388,9 +409,9 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 	}
 
 	void SSIDTimePoint::to_json(Poco::JSON::Object &Obj) const {
-		field_to_json(Obj, "bssid", bssid);
+		mac_to_json(Obj, "bssid", bssid, ':');
 		field_to_json(Obj, "mode", mode);
-		field_to_json(Obj, "ssid", ssid);
+		field_to_json(Obj, "ssid", ssid.str());
 		field_to_json(Obj, "band", band);
 		field_to_json(Obj, "channel", channel);
 		field_to_json(Obj, "associations", associations);
@@ -405,9 +426,9 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 
 	bool SSIDTimePoint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 		try {
-			field_from_json(Obj, "bssid", bssid);
+			mac_from_json(Obj, "bssid", bssid);
 			field_from_json(Obj, "mode", mode);
-			field_from_json(Obj, "ssid", ssid);
+			ssid_from_json(Obj, "ssid", ssid);
 			field_from_json(Obj, "band", band);
 			field_from_json(Obj, "channel", channel);
 			field_from_json(Obj, "associations", associations);
@@ -452,6 +473,7 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 	}
 
 	void DeviceTimePointAnalysis::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "timestamp", timestamp);
 		field_to_json(Obj, "noise", noise);
 		field_to_json(Obj, "temperature", temperature);
 		field_to_json(Obj, "active_pct", active_pct);
@@ -471,6 +493,7 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 
 	bool DeviceTimePointAnalysis::from_json(const Poco::JSON::Object::Ptr &Obj) {
 		try {
+			field_from_json(Obj, "timestamp", timestamp);
 			field_from_json(Obj, "noise", noise);
 			field_from_json(Obj, "temperature", temperature);
 			field_from_json(Obj, "active_pct", active_pct);
@@ -545,11 +568,179 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 		return false;
 	}
 
+	void StatAccumulator::Add(double v) {
+		if (v != 0.0 && (min == 0.0 || v < min))
+			min = v;
+		if (count == 0 || v > max)
+			max = v;
+		sum += v;
+		count++;
+	}
+
+	void StatAccumulator::Merge(const StatAccumulator &A) {
+		if (A.count == 0)
+			return;
+		if (A.min != 0.0 && (min == 0.0 || A.min < min))
+			min = A.min;
+		if (count == 0 || A.max > max)
+			max = A.max;
+		sum += A.sum;
+		count += A.count;
+	}
+
+	void StatAccumulator::Fill(AveragePoint &P) const {
+		P.min = min;
+		P.max = max;
+		P.avg = count ? sum / (double)count : 0.0;
+	}
+
+	void StatAccumulator::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "count", count);
+		field_to_json(Obj, "sum", sum);
+		field_to_json(Obj, "min", min);
+		field_to_json(Obj, "max", max);
+	}
+
+	bool StatAccumulator::from_json(const Poco::JSON::Object::Ptr &Obj) {
+		try {
+			field_from_json(Obj, "count", count);
+			field_from_json(Obj, "sum", sum);
+			field_from_json(Obj, "min", min);
+			field_from_json(Obj, "max", max);
+			return true;
+		} catch (...) {
+		}
+		return false;
+	}
+
+	void BoardStatsBucket::Add(const DeviceTimePoint &P) {
+		points++;
+		tx_bytes_bw.Add(P.ap_data.tx_bytes_bw);
+		rx_bytes_bw.Add(P.ap_data.rx_bytes_bw);
+		rx_dropped_pct.Add(P.ap_data.rx_dropped_pct);
+		tx_dropped_pct.Add(P.ap_data.tx_dropped_pct);
+		rx_packets_bw.Add(P.ap_data.rx_packets_bw);
+		tx_packets_bw.Add(P.ap_data.tx_packets_bw);
+		rx_errors_pct.Add(P.ap_data.rx_errors_pct);
+		tx_errors_pct.Add(P.ap_data.tx_errors_pct);
+		for (const auto &radio : P.radio_data) {
+			noise.Add((double)radio.noise);
+			temperature.Add((double)radio.temperature);
+			active_pct.Add((double)radio.active_pct);
+			busy_pct.Add((double)radio.busy_pct);
+			receive_pct.Add((double)radio.receive_pct);
+			transmit_pct.Add((double)radio.transmit_pct);
+			tx_power.Add((double)radio.tx_power);
+		}
+	}
+
+	void BoardStatsBucket::Merge(const BoardStatsBucket &B) {
+		points += B.points;
+		noise.Merge(B.noise);
+		temperature.Merge(B.temperature);
+		active_pct.Merge(B.active_pct);
+		busy_pct.Merge(B.busy_pct);
+		receive_pct.Merge(B.receive_pct);
+		transmit_pct.Merge(B.transmit_pct);
+		tx_power.Merge(B.tx_power);
+		tx_bytes_bw.Merge(B.tx_bytes_bw);
+		rx_bytes_bw.Merge(B.rx_bytes_bw);
+		rx_dropped_pct.Merge(B.rx_dropped_pct);
+		tx_dropped_pct.Merge(B.tx_dropped_pct);
+		rx_packets_bw.Merge(B.rx_packets_bw);
+		tx_packets_bw.Merge(B.tx_packets_bw);
+		rx_errors_pct.Merge(B.rx_errors_pct);
+		tx_errors_pct.Merge(B.tx_errors_pct);
+	}
+
+	void BoardStatsBucket::Fill(DeviceTimePointAnalysis &A) const {
+		A.timestamp = timestamp;
+		noise.Fill(A.noise);
+		temperature.Fill(A.temperature);
+		active_pct.Fill(A.active_pct);
+		busy_pct.Fill(A.busy_pct);
+		receive_pct.Fill(A.receive_pct);
+		transmit_pct.Fill(A.transmit_pct);
+		tx_power.Fill(A.tx_power);
+		tx_bytes_bw.Fill(A.tx_bytes_bw);
+		rx_bytes_bw.Fill(A.rx_bytes_bw);
+		rx_dropped_pct.Fill(A.rx_dropped_pct);
+		tx_dropped_pct.Fill(A.tx_dropped_pct);
+		rx_packets_bw.Fill(A.rx_packets_bw);
+		tx_packets_bw.Fill(A.tx_packets_bw);
+		rx_errors_pct.Fill(A.rx_errors_pct);
+		tx_errors_pct.Fill(A.tx_errors_pct);
+	}
+
+	void BoardStatsBucket::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "noise", noise);
+		field_to_json(Obj, "temperature", temperature);
+		field_to_json(Obj, "active_pct", active_pct);
+		field_to_json(Obj, "busy_pct", busy_pct);
+		field_to_json(Obj, "receive_pct", receive_pct);
+		field_to_json(Obj, "transmit_pct", transmit_pct);
+		field_to_json(Obj, "tx_power", tx_power);
+		field_to_json(Obj, "tx_bytes_bw", tx_bytes_bw);
+		field_to_json(Obj, "rx_bytes_bw", rx_bytes_bw);
+		field_to_json(Obj, "rx_dropped_pct", rx_dropped_pct);
+		field_to_json(Obj, "tx_dropped_pct", tx_dropped_pct);
+		field_to_json(Obj, "rx_packets_bw", rx_packets_bw);
+		field_to_json(Obj, "tx_packets_bw", tx_packets_bw);
+		field_to_json(Obj, "rx_errors_pct", rx_errors_pct);
+		field_to_json(Obj, "tx_errors_pct", tx_errors_pct);
+	}
+
+	bool BoardStatsBucket::from_json(const Poco::JSON::Object::Ptr &Obj) {
+		try {
+			field_from_json(Obj, "noise", noise);
+			field_from_json(Obj, "temperature", temperature);
+			field_from_json(Obj, "active_pct", active_pct);
+			field_from_json(Obj, "busy_pct", busy_pct);
+			field_from_json(Obj, "receive_pct", receive_pct);
+			field_from_json(Obj, "transmit_pct", transmit_pct);
+			field_from_json(Obj, "tx_power", tx_power);
+			field_from_json(Obj, "tx_bytes_bw", tx_bytes_bw);
+			field_from_json(Obj, "rx_bytes_bw", rx_bytes_bw);
+			field_from_json(Obj, "rx_dropped_pct", rx_dropped_pct);
+			field_from_json(Obj, "tx_dropped_pct", tx_dropped_pct);
+			field_from_json(Obj, "rx_packets_bw", rx_packets_bw);
+			field_from_json(Obj, "tx_packets_bw", tx_packets_bw);
+			field_from_json(Obj, "rx_errors_pct", rx_errors_pct);
+			field_from_json(Obj, "tx_errors_pct", tx_errors_pct);
+			return true;
+		} catch (...) {
+		}
+		return false;
+	}
+
+	void BandwidthAnalysisEntry::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "timestamp", timestamp);
+		field_to_json(Obj, "tx_bytes", tx_bytes);
+		field_to_json(Obj, "rx_bytes", rx_bytes);
+		field_to_json(Obj, "tx_bytes_bw", tx_bytes_bw);
+		field_to_json(Obj, "rx_bytes_bw", rx_bytes_bw);
+	}
+
+	void BandwidthAnalysisSeries::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "key", key);
+		field_to_json(Obj, "points", points);
+	}
+
+	void BandwidthAnalysis::to_json(Poco::JSON::Object &Obj) const {
+		field_to_json(Obj, "start", start);
+		field_to_json(Obj, "end", end);
+		field_to_json(Obj, "interval", interval);
+		field_to_json(Obj, "total", total);
+		field_to_json(Obj, "aps", aps);
+		field_to_json(Obj, "ssids", ssids);
+		field_to_json(Obj, "bands", bands);
+	}
+
 	void WifiClientHistory::to_json(Poco::JSON::Object &Obj) const {
 		field_to_json(Obj, "timestamp", timestamp);
-		field_to_json(Obj, "station_id", station_id);
-		field_to_json(Obj, "bssid", bssid);
-		field_to_json(Obj, "ssid", ssid);
+		mac_to_json(Obj, "station_id", station_id, 0);
+		mac_to_json(Obj, "bssid", bssid, 0);
+		field_to_json(Obj, "ssid", ssid.str());
 		field_to_json(Obj, "rssi", rssi);
 		field_to_json(Obj, "rx_bitrate", rx_bitrate);
 		field_to_json(Obj, "rx_chwidth", rx_chwidth);
@@ -588,9 +779,9 @@ bool Fingerprint::from_json(const Poco::JSON::Object::Ptr &Obj) {
 	bool WifiClientHistory::from_json(const Poco::JSON::Object::Ptr &Obj) {
 		try {
 			field_from_json(Obj, "timestamp", timestamp);
-			field_from_json(Obj, "station_id", station_id);
-			field_from_json(Obj, "bssid", bssid);
-			field_from_json(Obj, "ssid", ssid);
+			mac_from_json(Obj, "station_id", station_id);
+			mac_from_json(Obj, "bssid", bssid);
+			ssid_from_json(Obj, "ssid", ssid);
 			field_from_json(Obj, "rssi", rssi);
 			field_from_json(Obj, "rx_bitrate", rx_bitrate);
 			field_from_json(Obj, "rx_chwidth", rx_chwidth);
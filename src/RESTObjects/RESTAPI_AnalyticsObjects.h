@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include "MACAddress.h"
 #include "RESTAPI_ProvObjects.h"
+#include "StringDictionary.h"
 #include "framework/utils.h"
 #include <vector>
 
@@ -115,7 +117,7 @@ namespace OpenWifi {
 		};
 
 		struct UETimePoint {
-			std::string station;
+			MACAddress station;
 			int64_t rssi = 0;
 			uint64_t tx_bytes = 0, rx_bytes = 0, tx_duration = 0, rx_packets = 0, tx_packets = 0,
 					 tx_retries = 0, tx_failed = 0, connected = 0, inactive = 0;
@@ -154,7 +156,9 @@ namespace OpenWifi {
 		}
 
 		struct SSIDTimePoint {
-			std::string bssid, mode, ssid;
+			MACAddress bssid;
+			std::string mode;
+			SSIDName ssid;
 			uint64_t band = 0, channel = 0;
 			std::vector<UETimePoint> associations;
 
@@ -233,7 +237,7 @@ namespace OpenWifi {
 		};
 
 		struct DeviceTimePointAnalysis {
-			uint64_t timestamp;
+			uint64_t timestamp = 0;
 
 			AveragePoint noise;
 			AveragePoint temperature;
@@ -263,11 +267,64 @@ namespace OpenWifi {
 			bool from_json(const Poco::JSON::Object::Ptr &Obj);
 		};
 
+		//	Running count, sum, min and max of a value. Two accumulators merge into the one for
+		//	both series, so per bucket summaries can be kept instead of the values themselves.
+		//	As in the time point analysis, zeros are not counted for the minimum.
+		struct StatAccumulator {
+			uint64_t count = 0;
+			double sum = 0.0, min = 0.0, max = 0.0;
+
+			void Add(double v);
+			void Merge(const StatAccumulator &A);
+			void Fill(AveragePoint &P) const;
+
+			void to_json(Poco::JSON::Object &Obj) const;
+			bool from_json(const Poco::JSON::Object::Ptr &Obj);
+		};
+
+		//	The DeviceTimePointAnalysis of all the points a board stored in one time bucket,
+		//	kept as accumulators so that it can be built as points arrive.
+		struct BoardStatsBucket {
+			std::string boardId;
+			uint64_t timestamp = 0;
+			uint64_t points = 0;
+
+			StatAccumulator noise, temperature, active_pct, busy_pct, receive_pct, transmit_pct,
+				tx_power;
+			StatAccumulator tx_bytes_bw, rx_bytes_bw, rx_dropped_pct, tx_dropped_pct,
+				rx_packets_bw, tx_packets_bw, rx_errors_pct, tx_errors_pct;
+
+			void Add(const DeviceTimePoint &P);
+			void Merge(const BoardStatsBucket &B);
+			void Fill(DeviceTimePointAnalysis &A) const;
+
+			//	The accumulators only: boardId, timestamp and points are columns of their own.
+			void to_json(Poco::JSON::Object &Obj) const;
+			bool from_json(const Poco::JSON::Object::Ptr &Obj);
+		};
+
 		struct BandwidthAnalysisEntry {
 			uint64_t timestamp = 0;
+			uint64_t tx_bytes = 0, rx_bytes = 0;
+			uint64_t tx_bytes_bw = 0, rx_bytes_bw = 0;
+
+			void to_json(Poco::JSON::Object &Obj) const;
 		};
 
-		struct BandwidthAnalysis {};
+		struct BandwidthAnalysisSeries {
+			std::string key;
+			std::vector<BandwidthAnalysisEntry> points;
+
+			void to_json(Poco::JSON::Object &Obj) const;
+		};
+
+		struct BandwidthAnalysis {
+			uint64_t start = 0, end = 0, interval = 0;
+			std::vector<BandwidthAnalysisEntry> total;
+			std::vector<BandwidthAnalysisSeries> aps, ssids, bands;
+
+			void to_json(Poco::JSON::Object &Obj) const;
+		};
 
 		struct AverageValueSigned {
 			int64_t peak = 0, avg = 0, low = 0;
@@ -305,9 +362,9 @@ namespace OpenWifi {
 
 		struct WifiClientHistory {
 			uint64_t timestamp = Utils::Now();
-			std::string station_id;
-			std::string bssid;
-			std::string ssid;
+			MACAddress station_id;
+			MACAddress bssid;
+			SSIDName ssid;
 			int64_t rssi = 0;
 			uint32_t rx_bitrate = 0;
 			uint32_t rx_chwidth = 0;
@@ -0,0 +1,763 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "StateParser.h"
+#include "nlohmann/json.hpp"
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
+
+namespace OpenWifi {
+
+	//	Counts what goes through a memory resource.
+	class CountingResource : public std::pmr::memory_resource {
+	  public:
+		explicit CountingResource(std::pmr::memory_resource *Upstream) : Upstream_(Upstream) {}
+		uint64_t Allocations = 0, Bytes = 0;
+
+	  private:
+		std::pmr::memory_resource *Upstream_;
+
+		void *do_allocate(std::size_t Bytes_, std::size_t Alignment) override {
+			Allocations++;
+			Bytes += Bytes_;
+			return Upstream_->allocate(Bytes_, Alignment);
+		}
+		void do_deallocate(void *P, std::size_t Bytes_, std::size_t Alignment) override {
+			Upstream_->deallocate(P, Bytes_, Alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override {
+			return this == &Other;
+		}
+	};
+
+	static int BandToInt(const std::string &band) {
+		if (band == "2G")
+			return 2;
+		if (band == "5G")
+			return 5;
+		if (band == "6G")
+			return 6;
+		return 2;
+	}
+
+	//	"#/radios/1" -> 1
+	static bool RadioRef(const std::string &ref, int64_t &location) {
+		auto first = ref.find('/');
+		if (first == std::string::npos)
+			return false;
+		auto second = ref.find('/', first + 1);
+		if (second == std::string::npos || ref.find('/', second + 1) != std::string::npos)
+			return false;
+		location = std::strtol(ref.c_str() + second + 1, nullptr, 10);
+		return true;
+	}
+
+	class StateSaxHandler {
+	  public:
+		using json = nlohmann::json;
+
+		StateSaxHandler(StateReport &R, std::pmr::memory_resource *Arena)
+			: R_(R), Stack_(Arena), RadioMap_(Arena), ICEM_(Arena), ClientIPv4_(Arena),
+			  ClientIPv6_(Arena), SSIDInfos_(Arena), Capture_(Arena) {
+			Stack_.reserve(16);
+		}
+
+		bool null() { return Scalar(Value{}); }
+		bool boolean(bool v) {
+			Value V;
+			V.type = Value::boolean;
+			V.b = v;
+			return Scalar(V);
+		}
+		bool number_integer(json::number_integer_t v) {
+			Value V;
+			V.type = Value::integer;
+			V.i = v;
+			return Scalar(V);
+		}
+		bool number_unsigned(json::number_unsigned_t v) {
+			Value V;
+			V.type = Value::unsigned_integer;
+			V.u = v;
+			return Scalar(V);
+		}
+		bool number_float(json::number_float_t v, const json::string_t &raw) {
+			Value V;
+			V.type = Value::floating;
+			V.d = v;
+			V.s = &raw;
+			return Scalar(V);
+		}
+		bool string(json::string_t &v) {
+			Value V;
+			V.type = Value::string;
+			V.s = &v;
+			return Scalar(V);
+		}
+		bool binary(json::binary_t &) { return Scalar(Value{}); }
+
+		bool key(json::string_t &k) {
+			if (!Capture_.empty()) {
+				CaptureKey_ = k;
+				return true;
+			}
+			Key_ = k;
+			return true;
+		}
+
+		bool start_object(std::size_t) { return Start(true); }
+		bool start_array(std::size_t) { return Start(false); }
+		bool end_object() { return End(); }
+		bool end_array() { return End(); }
+
+		bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) {
+			return false;
+		}
+
+		void Finish();
+
+	  private:
+		struct Value {
+			enum { null, boolean, integer, unsigned_integer, floating, string } type = null;
+			bool b = false;
+			int64_t i = 0;
+			uint64_t u = 0;
+			double d = 0.0;
+			const std::string *s = nullptr;
+		};
+
+		enum class Ctx : uint8_t {
+			Skip,
+			Message,
+			Payload,
+			State,
+			Unit,
+			Memory,
+			Radios,
+			Radio,
+			RadioBand,
+			Interfaces,
+			Interface,
+			Counters,
+			Clients,
+			Client,
+			ClientIPv4,
+			ClientIPv6,
+			SSIDs,
+			SSID,
+			SSIDRadio,
+			Associations,
+			Association,
+			RxRate,
+			TxRate,
+			TidStats,
+			TidStat
+		};
+
+		struct SSIDInfo {
+			bool has_band = false, has_ref = false;
+			int64_t radio_location = 0;
+			uint64_t associations = 0;
+			std::size_t first_client = 0, last_client = 0;
+		};
+
+		struct RadioInfo {
+			uint64_t band = 0, channel = 0;
+		};
+
+		StateReport &R_;
+		std::pmr::vector<Ctx> Stack_;
+		std::string Key_;
+
+		AnalyticsObjects::RadioTimePoint Radio_;
+		bool RadioHasChannel_ = false, RadioHasBand_ = false;
+		uint64_t RadioBandIndex_ = 0;
+		std::pmr::vector<RadioInfo> RadioMap_;
+
+		std::size_t InterfaceFirstClient_ = 0;
+		std::pmr::map<MACAddress, std::pair<std::pmr::string, std::pmr::string>> ICEM_;
+		MACAddress ClientMac_;
+		std::pmr::string ClientIPv4_, ClientIPv6_;
+
+		AnalyticsObjects::SSIDTimePoint SSID_;
+		SSIDInfo SSIDInfo_;
+		std::pmr::vector<SSIDInfo> SSIDInfos_;
+
+		AnalyticsObjects::UETimePoint UE_;
+		AnalyticsObjects::WifiClientHistory WFH_;
+		AnalyticsObjects::TIDstat_entry TID_;
+
+		//	Association fingerprints are kept as their JSON text, as json::dump() writes it: with
+		//	sorted keys. Only that sub-document is built, then dumped. Capture_ holds the objects
+		//	and arrays still open in it.
+		json Fingerprint_;
+		std::pmr::vector<json *> Capture_;
+		std::string CaptureKey_;
+
+		template <typename T> static void Get(const Value &V, T &v) {
+			switch (V.type) {
+			case Value::boolean:
+				v = static_cast<T>(V.b);
+				break;
+			case Value::integer:
+				v = static_cast<T>(V.i);
+				break;
+			case Value::unsigned_integer:
+				v = static_cast<T>(V.u);
+				break;
+			case Value::floating:
+				v = static_cast<T>(V.d);
+				break;
+			default:
+				break;
+			}
+		}
+
+		static void Get(const Value &V, bool &v) {
+			if (V.type == Value::boolean)
+				v = V.b;
+		}
+
+		static void Get(const Value &V, std::string &v) {
+			if (V.type == Value::string)
+				v = *V.s;
+		}
+
+		static void Get(const Value &V, std::pmr::string &v) {
+			if (V.type == Value::string)
+				v.assign(V.s->data(), V.s->size());
+		}
+
+		static void Get(const Value &V, MACAddress &v) {
+			if (V.type == Value::string)
+				v = MACAddress::FromString(*V.s);
+		}
+
+		static void Get(const Value &V, SSIDName &v) {
+			if (V.type == Value::string)
+				v = SSIDName(*V.s);
+		}
+
+		inline Ctx Top() const { return Stack_.empty() ? Ctx::Skip : Stack_.back(); }
+
+		Ctx Child(bool IsObject) const;
+		bool Start(bool IsObject);
+		bool End();
+		bool Scalar(const Value &V);
+
+		static json ToJson(const Value &V);
+		json &Capture(json &&V);
+	};
+
+	StateSaxHandler::Ctx StateSaxHandler::Child(bool IsObject) const {
+		switch (Top()) {
+		case Ctx::Message:
+			if (IsObject && Key_ == "payload")
+				return Ctx::Payload;
+			break;
+		case Ctx::Payload:
+			if (IsObject && Key_ == "state")
+				return Ctx::State;
+			break;
+		case Ctx::State:
+			if (IsObject && Key_ == "unit")
+				return Ctx::Unit;
+			if (!IsObject && Key_ == "radios")
+				return Ctx::Radios;
+			if (!IsObject && Key_ == "interfaces")
+				return Ctx::Interfaces;
+			break;
+		case Ctx::Unit:
+			if (IsObject && Key_ == "memory")
+				return Ctx::Memory;
+			break;
+		case Ctx::Radios:
+			if (IsObject)
+				return Ctx::Radio;
+			break;
+		case Ctx::Radio:
+			if (!IsObject && Key_ == "band")
+				return Ctx::RadioBand;
+			break;
+		case Ctx::Interfaces:
+			if (IsObject)
+				return Ctx::Interface;
+			break;
+		case Ctx::Interface:
+			if (IsObject && Key_ == "counters")
+				return Ctx::Counters;
+			if (!IsObject && Key_ == "clients")
+				return Ctx::Clients;
+			if (!IsObject && Key_ == "ssids")
+				return Ctx::SSIDs;
+			break;
+		case Ctx::Clients:
+			if (IsObject)
+				return Ctx::Client;
+			break;
+		case Ctx::Client:
+			if (!IsObject && Key_ == "ipv4_addresses")
+				return Ctx::ClientIPv4;
+			if (!IsObject && Key_ == "ipv6_addresses")
+				return Ctx::ClientIPv6;
+			break;
+		case Ctx::SSIDs:
+			if (IsObject)
+				return Ctx::SSID;
+			break;
+		case Ctx::SSID:
+			if (IsObject && Key_ == "radio")
+				return Ctx::SSIDRadio;
+			if (!IsObject && Key_ == "associations")
+				return Ctx::Associations;
+			break;
+		case Ctx::Associations:
+			if (IsObject)
+				return Ctx::Association;
+			break;
+		case Ctx::Association:
+			if (IsObject && Key_ == "rx_rate")
+				return Ctx::RxRate;
+			if (IsObject && Key_ == "tx_rate")
+				return Ctx::TxRate;
+			if (!IsObject && Key_ == "tid_stats")
+				return Ctx::TidStats;
+			break;
+		case Ctx::TidStats:
+			if (IsObject)
+				return Ctx::TidStat;
+			break;
+		default:
+			break;
+		}
+		return Ctx::Skip;
+	}
+
+	bool StateSaxHandler::Start(bool IsObject) {
+		if (!Capture_.empty()) {
+			Capture_.push_back(&Capture(IsObject ? json::object() : json::array()));
+			return true;
+		}
+
+		if (Top() == Ctx::Association && Key_ == "fingerprint") {
+			Fingerprint_ = IsObject ? json::object() : json::array();
+			Capture_.push_back(&Fingerprint_);
+			return true;
+		}
+
+		auto C = Stack_.empty() ? (IsObject ? Ctx::Message : Ctx::Skip) : Child(IsObject);
+		switch (C) {
+		case Ctx::State:
+			R_.has_state = true;
+			break;
+		case Ctx::Unit:
+			R_.has_unit = true;
+			break;
+		case Ctx::Memory:
+			R_.has_memory = true;
+			break;
+		case Ctx::Radio:
+			Radio_ = AnalyticsObjects::RadioTimePoint{};
+			Radio_.temperature = 20;
+			Radio_.noise = -90;
+			RadioHasChannel_ = RadioHasBand_ = false;
+			break;
+		case Ctx::RadioBand:
+			RadioHasBand_ = true;
+			RadioBandIndex_ = 0;
+			break;
+		case Ctx::Interface:
+			InterfaceFirstClient_ = R_.clients.size();
+			ICEM_.clear();
+			break;
+		case Ctx::Counters:
+			R_.DTP.ap_data = AnalyticsObjects::APTimePoint{};
+			break;
+		case Ctx::Client:
+			ClientMac_ = MACAddress();
+			ClientIPv4_.clear();
+			ClientIPv6_.clear();
+			break;
+		case Ctx::SSID:
+			SSID_ = AnalyticsObjects::SSIDTimePoint{};
+			SSID_.band = 2;
+			SSIDInfo_ = SSIDInfo{};
+			SSIDInfo_.first_client = R_.clients.size();
+			break;
+		case Ctx::Association:
+			UE_ = AnalyticsObjects::UETimePoint{};
+			WFH_ = AnalyticsObjects::WifiClientHistory{};
+			SSIDInfo_.associations++;
+			break;
+		case Ctx::TidStat:
+			TID_ = AnalyticsObjects::TIDstat_entry{};
+			break;
+		default:
+			break;
+		}
+		Stack_.push_back(C);
+		return true;
+	}
+
+	bool StateSaxHandler::End() {
+		if (!Capture_.empty()) {
+			Capture_.pop_back();
+			if (Capture_.empty())
+				UE_.fingerprint.json = Fingerprint_.dump();
+			return true;
+		}
+
+		if (Stack_.empty())
+			return false;
+		auto C = Stack_.back();
+		Stack_.pop_back();
+
+		switch (C) {
+		case Ctx::Radio:
+			if (RadioHasChannel_) {
+				if (!RadioHasBand_)
+					Radio_.band = Radio_.channel <= 16 ? 2 : 5;
+				if (Radio_.temperature == 0)
+					Radio_.temperature = 20;
+				if (Radio_.noise == 0)
+					Radio_.noise = -90;
+				RadioMap_.push_back(RadioInfo{Radio_.band, Radio_.channel});
+				R_.DTP.radio_data.push_back(Radio_);
+			}
+			break;
+		case Ctx::Client:
+			if (!ClientMac_.Empty()) {
+				auto &IPs = ICEM_[ClientMac_];
+				IPs.first = ClientIPv4_;
+				IPs.second = ClientIPv6_;
+			}
+			break;
+		case Ctx::Interface:
+			//	clients may come after the ssids in the document, so IPs are resolved here.
+			for (auto i = InterfaceFirstClient_; i < R_.clients.size(); ++i) {
+				auto &WFH = R_.clients[i];
+				auto It = ICEM_.find(WFH.station_id);
+				if (It != ICEM_.end()) {
+					WFH.ipv4.assign(It->second.first.data(), It->second.first.size());
+					WFH.ipv6.assign(It->second.second.data(), It->second.second.size());
+				}
+			}
+			break;
+		case Ctx::SSID: {
+			SSIDInfo_.last_client = R_.clients.size();
+			for (auto i = SSIDInfo_.first_client; i < SSIDInfo_.last_client; ++i) {
+				auto &WFH = R_.clients[i];
+				WFH.bssid = SSID_.bssid;
+				WFH.ssid = SSID_.ssid;
+				WFH.mode = SSID_.mode;
+			}
+			R_.DTP.ssid_data.push_back(std::move(SSID_));
+			SSIDInfos_.push_back(SSIDInfo_);
+		} break;
+		case Ctx::Association:
+			//	A client without a usable station MAC has no history to be filed under.
+			if (!UE_.station.Empty()) {
+				WFH_.station_id = UE_.station;
+				WFH_.rssi = UE_.rssi;
+				R_.clients.push_back(std::move(WFH_));
+			}
+			SSID_.associations.push_back(std::move(UE_));
+			break;
+		case Ctx::TidStat:
+			UE_.tidstats.push_back(TID_);
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	StateSaxHandler::json StateSaxHandler::ToJson(const Value &V) {
+		switch (V.type) {
+		case Value::boolean:
+			return V.b;
+		case Value::integer:
+			return V.i;
+		case Value::unsigned_integer:
+			return V.u;
+		case Value::floating:
+			return V.d;
+		case Value::string:
+			return *V.s;
+		default:
+			return nullptr;
+		}
+	}
+
+	//	Adds V to the innermost open object or array of the fingerprint. As in json::parse(), the
+	//	last of duplicate keys wins.
+	StateSaxHandler::json &StateSaxHandler::Capture(json &&V) {
+		auto &Parent = *Capture_.back();
+		if (Parent.is_object())
+			return Parent[CaptureKey_] = std::move(V);
+		Parent.push_back(std::move(V));
+		return Parent.back();
+	}
+
+	bool StateSaxHandler::Scalar(const Value &V) {
+		if (!Capture_.empty()) {
+			Capture(ToJson(V));
+			return true;
+		}
+
+		switch (Top()) {
+		case Ctx::Payload:
+			if (Key_ == "serial")
+				Get(V, R_.serialNumber);
+			break;
+		case Ctx::Unit:
+			if (Key_ == "localtime")
+				Get(V, R_.localtime);
+			else if (Key_ == "uptime")
+				Get(V, R_.uptime);
+			break;
+		case Ctx::Memory:
+			if (Key_ == "free")
+				Get(V, R_.memory_free);
+			else if (Key_ == "total")
+				Get(V, R_.memory_total);
+			break;
+		case Ctx::Radio:
+			if (Key_ == "channel") {
+				RadioHasChannel_ = true;
+				Get(V, Radio_.channel);
+			} else if (Key_ == "busy_ms")
+				Get(V, Radio_.busy_ms);
+			else if (Key_ == "receive_ms")
+				Get(V, Radio_.receive_ms);
+			else if (Key_ == "transmit_ms")
+				Get(V, Radio_.transmit_ms);
+			else if (Key_ == "active_ms")
+				Get(V, Radio_.active_ms);
+			else if (Key_ == "tx_power")
+				Get(V, Radio_.tx_power);
+			else if (Key_ == "temperature")
+				Get(V, Radio_.temperature);
+			else if (Key_ == "noise")
+				Get(V, Radio_.noise);
+			else if (Key_ == "channel_width") {
+				if (V.type == Value::string)
+					Radio_.channel_width = std::strtoull(V.s->c_str(), nullptr, 10);
+				else if (V.type == Value::integer || V.type == Value::unsigned_integer)
+					Get(V, Radio_.channel_width);
+				else if (V.type != Value::null)
+					Radio_.channel_width = 20;
+			}
+			break;
+		case Ctx::RadioBand:
+			if (RadioBandIndex_++ == 0 && V.type == Value::string)
+				Radio_.band = BandToInt(*V.s);
+			break;
+		case Ctx::Counters: {
+			auto &AP = R_.DTP.ap_data;
+			if (Key_ == "collisions")
+				Get(V, AP.collisions);
+			else if (Key_ == "multicast")
+				Get(V, AP.multicast);
+			else if (Key_ == "rx_bytes")
+				Get(V, AP.rx_bytes);
+			else if (Key_ == "rx_dropped")
+				Get(V, AP.rx_dropped);
+			else if (Key_ == "rx_errors")
+				Get(V, AP.rx_errors);
+			else if (Key_ == "rx_packets")
+				Get(V, AP.rx_packets);
+			else if (Key_ == "tx_bytes")
+				Get(V, AP.tx_bytes);
+			else if (Key_ == "tx_dropped")
+				Get(V, AP.tx_dropped);
+			else if (Key_ == "tx_errors")
+				Get(V, AP.tx_errors);
+			else if (Key_ == "tx_packets")
+				Get(V, AP.tx_packets);
+		} break;
+		case Ctx::Client:
+			if (Key_ == "mac")
+				Get(V, ClientMac_);
+			break;
+		case Ctx::ClientIPv4:
+			if (ClientIPv4_.empty())
+				Get(V, ClientIPv4_);
+			break;
+		case Ctx::ClientIPv6:
+			if (ClientIPv6_.empty())
+				Get(V, ClientIPv6_);
+			break;
+		case Ctx::SSID:
+			if (Key_ == "band" && V.type == Value::string) {
+				SSIDInfo_.has_band = true;
+				SSID_.band = BandToInt(*V.s);
+			} else if (Key_ == "bssid")
+				Get(V, SSID_.bssid);
+			else if (Key_ == "mode")
+				Get(V, SSID_.mode);
+			else if (Key_ == "ssid")
+				Get(V, SSID_.ssid);
+			break;
+		case Ctx::SSIDRadio:
+			if (Key_ == "$ref" && V.type == Value::string)
+				SSIDInfo_.has_ref = RadioRef(*V.s, SSIDInfo_.radio_location);
+			break;
+		case Ctx::Association:
+			if (Key_ == "station")
+				Get(V, UE_.station);
+			else if (Key_ == "rssi")
+				Get(V, UE_.rssi);
+			else if (Key_ == "tx_bytes") {
+				Get(V, UE_.tx_bytes);
+				Get(V, WFH_.tx_bytes);
+			} else if (Key_ == "rx_bytes") {
+				Get(V, UE_.rx_bytes);
+				Get(V, WFH_.rx_bytes);
+			} else if (Key_ == "tx_duration") {
+				Get(V, UE_.tx_duration);
+				Get(V, WFH_.tx_duration);
+			} else if (Key_ == "rx_duration")
+				Get(V, WFH_.rx_duration);
+			else if (Key_ == "rx_packets") {
+				Get(V, UE_.rx_packets);
+				Get(V, WFH_.rx_packets);
+			} else if (Key_ == "tx_packets") {
+				Get(V, UE_.tx_packets);
+				Get(V, WFH_.tx_packets);
+			} else if (Key_ == "tx_retries") {
+				Get(V, UE_.tx_retries);
+				Get(V, WFH_.tx_retries);
+			} else if (Key_ == "tx_failed")
+				Get(V, UE_.tx_failed);
+			else if (Key_ == "connected") {
+				Get(V, UE_.connected);
+				Get(V, WFH_.connected);
+			} else if (Key_ == "inactive") {
+				Get(V, UE_.inactive);
+				Get(V, WFH_.inactive);
+			} else if (Key_ == "ack_signal")
+				Get(V, WFH_.ack_signal);
+			else if (Key_ == "ack_signal_avg")
+				Get(V, WFH_.ack_signal_avg);
+			else if (Key_ == "fingerprint")
+				UE_.fingerprint.json = ToJson(V).dump();
+			break;
+		case Ctx::RxRate:
+		case Ctx::TxRate: {
+			bool rx = Top() == Ctx::RxRate;
+			auto &Rate = rx ? UE_.rx_rate : UE_.tx_rate;
+			if (Key_ == "bitrate") {
+				Get(V, Rate.bitrate);
+				Get(V, rx ? WFH_.rx_bitrate : WFH_.tx_bitrate);
+			} else if (Key_ == "chwidth") {
+				Get(V, Rate.chwidth);
+				Get(V, rx ? WFH_.rx_chwidth : WFH_.tx_chwidth);
+			} else if (Key_ == "mcs") {
+				Get(V, Rate.mcs);
+				Get(V, rx ? WFH_.rx_mcs : WFH_.tx_mcs);
+			} else if (Key_ == "nss") {
+				Get(V, Rate.nss);
+				Get(V, rx ? WFH_.rx_nss : WFH_.tx_nss);
+			} else if (Key_ == "vht")
+				Get(V, rx ? WFH_.rx_vht : WFH_.tx_vht);
+			else if (Key_ == "ht")
+				Get(V, Rate.ht);
+			else if (Key_ == "sgi")
+				Get(V, Rate.sgi);
+		} break;
+		case Ctx::TidStat:
+			if (Key_ == "rx_msdu")
+				Get(V, TID_.rx_msdu);
+			else if (Key_ == "tx_msdu")
+				Get(V, TID_.tx_msdu);
+			else if (Key_ == "tx_msdu_failed")
+				Get(V, TID_.tx_msdu_failed);
+			else if (Key_ == "tx_msdu_retries")
+				Get(V, TID_.tx_msdu_retries);
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	//	Everything that depends on the radio list is resolved once the whole document is read,
+	//	since nothing guarantees "radios" comes before "interfaces".
+	void StateSaxHandler::Finish() {
+		for (std::size_t s = 0; s < SSIDInfos_.size(); ++s) {
+			const auto &Info = SSIDInfos_[s];
+			auto &SSID = R_.DTP.ssid_data[s];
+			bool RadioKnown =
+				Info.radio_location >= 0 && (std::size_t)Info.radio_location < RadioMap_.size();
+
+			if (Info.has_ref && RadioKnown) {
+				if (!Info.has_band)
+					SSID.band = RadioMap_[Info.radio_location].band;
+				SSID.channel = RadioMap_[Info.radio_location].channel;
+			}
+
+			if (RadioKnown) {
+				switch (RadioMap_[Info.radio_location].band) {
+				case 2:
+					R_.associations_2g += Info.associations;
+					break;
+				case 5:
+					R_.associations_5g += Info.associations;
+					break;
+				case 6:
+					R_.associations_6g += Info.associations;
+					break;
+				default:
+					break;
+				}
+			}
+
+			for (const auto &rd : R_.DTP.radio_data) {
+				if (rd.band != SSID.band)
+					continue;
+				for (auto i = Info.first_client; i < Info.last_client; ++i) {
+					auto &WFH = R_.clients[i];
+					WFH.channel_width = rd.channel_width;
+					WFH.noise = rd.noise;
+					WFH.tx_power = rd.tx_power;
+					WFH.channel = rd.channel;
+					WFH.active_ms = rd.active_ms;
+					WFH.busy_ms = rd.busy_ms;
+					WFH.receive_ms = rd.receive_ms;
+				}
+				break;
+			}
+		}
+	}
+
+	bool ParseState(const char *Data, std::size_t Size, StateReport &Report,
+					ParseCounters *Counters) {
+		//	Large enough for the scratch state of a dense AP; bigger messages spill to the heap.
+		thread_local std::array<std::byte, 64 * 1024> ArenaBuffer;
+
+		CountingResource Overflow(std::pmr::new_delete_resource());
+		std::pmr::monotonic_buffer_resource Buffer(ArenaBuffer.data(), ArenaBuffer.size(),
+												   &Overflow);
+		CountingResource Arena(&Buffer);
+
+		bool Result;
+		{
+			StateSaxHandler Handler(Report, &Arena);
+			Result = nlohmann::json::sax_parse(Data, Data + Size, &Handler);
+			if (Result)
+				Handler.Finish();
+		}
+
+		if (Counters != nullptr) {
+			Counters->arena_allocations = Arena.Allocations;
+			Counters->arena_bytes = Arena.Bytes;
+			Counters->arena_overflows = Overflow.Allocations;
+		}
+		return Result;
+	}
+
+} // namespace OpenWifi
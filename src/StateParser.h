@@ -0,0 +1,50 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	Everything AP::UpdateStats needs out of a device state message, filled straight from the
+	//	Kafka bytes by a SAX parser: no intermediate DOM is ever built.
+	struct StateReport {
+		std::string serialNumber;
+		bool has_state = false;
+
+		bool has_unit = false, has_memory = false;
+		uint64_t localtime = 0, uptime = 0, memory_free = 0, memory_total = 0;
+
+		uint64_t associations_2g = 0, associations_5g = 0, associations_6g = 0;
+
+		//	ap_data, radio_data and ssid_data are filled. Deltas and device_info are left to AP.
+		AnalyticsObjects::DeviceTimePoint DTP;
+		//	One entry per association, with ssid, IPs and radio data already resolved.
+		std::vector<AnalyticsObjects::WifiClientHistory> clients;
+	};
+
+	//	The parser's scratch state (context stack, per-interface client IPs, radio map...) lives
+	//	in a per-message arena released in one shot. These tell how it was used.
+	struct ParseCounters {
+		uint64_t arena_allocations = 0;
+		uint64_t arena_bytes = 0;
+		//	Allocations the arena had to get from the heap because its buffer was full.
+		uint64_t arena_overflows = 0;
+	};
+
+	//	Parses a full state message ({"payload":{"serial":..., "state":{...}}}). Returns false when
+	//	the JSON is malformed. Callers must also check has_state and serialNumber.
+	bool ParseState(const char *Data, std::size_t Size, StateReport &Report,
+					ParseCounters *Counters = nullptr);
+
+	inline bool ParseState(const std::string &Payload, StateReport &Report,
+						   ParseCounters *Counters = nullptr) {
+		return ParseState(Payload.data(), Payload.size(), Report, Counters);
+	}
+
+} // namespace OpenWifi
@@ -3,91 +3,135 @@
 //
 
 #include "StateReceiver.h"
+#include "DeviceRegistry.h"
+#include "StateParser.h"
 #include "VenueWatcher.h"
 #include "fmt/core.h"
 #include "framework/KafkaManager.h"
 #include "framework/KafkaTopics.h"
+#include "framework/MicroServiceFuncs.h"
 
 namespace OpenWifi {
 
+	void StateReceiverShard::Start() { Worker_.start(*this); }
+
+	void StateReceiverShard::Stop() {
+		Queue_.Shutdown();
+		Worker_.join();
+	}
+
+	void StateReceiverShard::run() {
+		Utils::SetThreadName(fmt::format("dev-state-{}", Id_).c_str());
+		Types::KafkaIncomingMessagePtr Msg;
+		while (Queue_.Pop(Msg)) {
+			StateReceiver()->ProcessState(Msg);
+			Msg.reset();
+			Processed_++;
+		}
+	}
+
 	int StateReceiver::Start() {
-		Running_ = true;
-		Types::TopicNotifyFunction F = [this](const std::string &Key, const std::string &Payload) {
-			this->StateReceived(Key, Payload);
+		auto NumberOfWorkers = MicroServiceConfigGetInt("stats.receiver.workers", 4);
+		if (NumberOfWorkers < 1)
+			NumberOfWorkers = 1;
+		auto QueueSize = MicroServiceConfigGetInt("stats.receiver.queue.size", 10000);
+		auto Policy =
+			OverloadPolicyFromString(MicroServiceConfigGetString("stats.receiver.queue.policy", "block"));
+		poco_notice(Logger(), fmt::format("Starting {} state workers (queue: {} {})...",
+										  NumberOfWorkers, QueueSize, OverloadPolicyToString(Policy)));
+
+		for (uint64_t i = 0; i < NumberOfWorkers; ++i) {
+			Shards_.push_back(std::make_unique<StateReceiverShard>(i, QueueSize, Policy));
+			Shards_.back()->Start();
+		}
+
+		Types::TopicNotifyFunction F = [this](const Types::KafkaIncomingMessagePtr &Msg) {
+			this->StateReceived(Msg);
 		};
 		StateWatcherId_ = KafkaManager()->RegisterTopicWatcher(KafkaTopics::STATE, F);
-		Worker_.start(*this);
 		return 0;
 	};
 
 	void StateReceiver::Stop() {
-		Running_ = false;
 		KafkaManager()->UnregisterTopicWatcher(KafkaTopics::STATE, StateWatcherId_);
-		Queue_.wakeUpAll();
-		Worker_.join();
+		for (auto &Shard : Shards_)
+			Shard->Stop();
+		Shards_.clear();
 	};
 
-	void StateReceiver::run() {
-		Poco::AutoPtr<Poco::Notification> Note(Queue_.waitDequeueNotification());
-		Utils::SetThreadName("dev-state");
-		while (Note && Running_) {
-			auto Msg = dynamic_cast<StateMessage *>(Note.get());
-			if (Msg != nullptr) {
-				try {
-					nlohmann::json msg = nlohmann::json::parse(Msg->Payload());
-					if (msg.contains(uCentralProtocol::PAYLOAD)) {
-						auto payload = msg[uCentralProtocol::PAYLOAD];
-						if (payload.contains("state") && payload.contains("serial")) {
-							auto serialNumber = payload["serial"].get<std::string>();
-							auto state = std::make_shared<nlohmann::json>(payload["state"]);
-							std::lock_guard G(Mutex_);
-							auto it = Notifiers_.find(Utils::SerialNumberToInt(serialNumber));
-							if (it != Notifiers_.end()) {
-								for (const auto &i : it->second) {
-									i->PostState(Utils::SerialNumberToInt(serialNumber), state);
-								}
-							}
-						}
-					}
-				} catch (const Poco::Exception &E) {
-					Logger().log(E);
-				} catch (...) {
-				}
-			} else {
+	void StateReceiver::ProcessState(const Types::KafkaIncomingMessagePtr &Msg) {
+		try {
+			auto Report = std::make_shared<StateReport>();
+			auto Start = std::chrono::steady_clock::now();
+			auto Payload = Msg->Payload();
+			ParseCounters Counters;
+			bool Parsed = ParseState(Payload.data(), Payload.size(), *Report, &Counters);
+			ParseTime_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+							  std::chrono::steady_clock::now() - Start)
+							  .count();
+			BytesParsed_ += Payload.size();
+			ArenaAllocations_ += Counters.arena_allocations;
+			ArenaBytes_ += Counters.arena_bytes;
+			ArenaOverflows_ += Counters.arena_overflows;
+			if (!Parsed || !Report->has_state || Report->serialNumber.empty()) {
+				ParseErrors_++;
+				return;
 			}
-			Note = Queue_.waitDequeueNotification();
+			Parsed_++;
+			auto SerialNumber = Utils::SerialNumberToInt(Report->serialNumber);
+			DeviceRegistry()->ForEach(SerialNumber, [&](VenueWatcher *VW) {
+				VW->PostState(SerialNumber, Report);
+			});
+		} catch (const Poco::Exception &E) {
+			Logger().log(E);
+		} catch (...) {
 		}
 	}
 
-	void StateReceiver::StateReceived(const std::string &Key, const std::string &Payload) {
-		std::lock_guard G(Mutex_);
-		poco_trace(Logger(), fmt::format("Device({}): State message.", Key));
-		Queue_.enqueueNotification(new StateMessage(Key, Payload));
-	}
-
-	void StateReceiver::Register(uint64_t SerialNumber, VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-		auto it = Notifiers_.find(SerialNumber);
-		if (it == Notifiers_.end()) {
-			std::list<VenueWatcher *> L;
-			L.push_back(VW);
-			Notifiers_[SerialNumber] = L;
-		} else {
-			it->second.push_back(VW);
+	void StateReceiver::StateReceived(const Types::KafkaIncomingMessagePtr &Msg) {
+		auto Key = Msg->Key();
+		uint64_t SerialNumber;
+		if (!DeviceRegistry::KeyToSerialNumber(Key, SerialNumber) ||
+			!DeviceRegistry()->Watched(SerialNumber)) {
+			Filtered_++;
+			return;
 		}
+		poco_trace(Logger(), fmt::format("Device({}): State message.", Key));
+		//	Kafka keys state messages with the device serial number, so hashing it keeps every
+		//	message from one device on the same worker.
+		auto Shard = std::hash<std::string_view>{}(Key) % Shards_.size();
+		Shards_[Shard]->Post(SerialNumber, Msg);
 	}
 
-	void StateReceiver::DeRegister(uint64_t SerialNumber, VenueWatcher *VW) {
-		std::lock_guard G(Mutex_);
-		auto it = Notifiers_.find(SerialNumber);
-		if (it == Notifiers_.end())
-			return;
-		for (auto i = it->second.begin(); i != it->second.end(); i++) {
-			if (*i == VW) {
-				it->second.erase(i);
-				break;
-			}
+	void StateReceiver::GetStats(Poco::JSON::Object &Obj) {
+		Poco::JSON::Array ShardArray;
+		uint64_t TotalDepth = 0, Dropped = 0, Coalesced = 0, BlockedNs = 0;
+		for (uint64_t i = 0; i < Shards_.size(); ++i) {
+			Poco::JSON::Object ShardObj;
+			auto &Queue = Shards_[i]->Queue();
+			Queue.GetStats(ShardObj);
+			TotalDepth += Queue.Size();
+			Dropped += Queue.Dropped();
+			Coalesced += Queue.Coalesced();
+			BlockedNs += Queue.BlockedNs();
+			ShardObj.set("shard", i);
+			ShardObj.set("processed", Shards_[i]->Processed());
+			ShardArray.add(ShardObj);
 		}
+		Obj.set("workers", Shards_.size());
+		Obj.set("queueDepth", TotalDepth);
+		Obj.set("dropped", Dropped);
+		Obj.set("coalesced", Coalesced);
+		Obj.set("blockedNs", BlockedNs);
+		Obj.set("filtered", Filtered_.load());
+		Obj.set("parsed", Parsed_.load());
+		Obj.set("parseErrors", ParseErrors_.load());
+		Obj.set("bytesParsed", BytesParsed_.load());
+		Obj.set("parseTimeNs", ParseTime_.load());
+		Obj.set("arenaAllocations", ArenaAllocations_.load());
+		Obj.set("arenaBytes", ArenaBytes_.load());
+		Obj.set("arenaOverflows", ArenaOverflows_.load());
+		Obj.set("shards", ShardArray);
 	}
 
-} // namespace OpenWifi
\ No newline at end of file
+} // namespace OpenWifi
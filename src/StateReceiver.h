@@ -3,26 +3,39 @@
 //
 
 #pragma once
-#include "Poco/Notification.h"
-#include "Poco/NotificationQueue.h"
+#include "BoundedQueue.h"
+#include "Poco/JSON/Object.h"
+#include "framework/KafkaManager.h"
 #include "framework/SubSystemServer.h"
 
 namespace OpenWifi {
-	class StateMessage : public Poco::Notification {
+	class VenueWatcher;
+
+	//	One parse worker. All the messages for a given device always land in the same shard so
+	//	the order in which a device reports its state is preserved.
+	class StateReceiverShard : public Poco::Runnable {
 	  public:
-		explicit StateMessage(const std::string &Key, const std::string &Payload)
-			: Key_(Key), Payload_(Payload) {}
-		const std::string &Key() { return Key_; }
-		const std::string &Payload() { return Payload_; }
+		StateReceiverShard(uint64_t Id, std::size_t QueueSize, OverloadPolicy Policy)
+			: Id_(Id), Queue_(QueueSize, Policy) {}
+
+		void Start();
+		void Stop();
+		void run() override;
+		inline void Post(uint64_t SerialNumber, const Types::KafkaIncomingMessagePtr &Msg) {
+			Queue_.Push(SerialNumber, Types::KafkaIncomingMessagePtr(Msg));
+		}
+		inline uint64_t QueueDepth() { return Queue_.Size(); }
+		inline uint64_t Processed() const { return Processed_; }
+		inline auto &Queue() { return Queue_; }
 
 	  private:
-		std::string Key_;
-		std::string Payload_;
+		uint64_t Id_ = 0;
+		BoundedQueue<Types::KafkaIncomingMessagePtr> Queue_;
+		Poco::Thread Worker_;
+		std::atomic_uint64_t Processed_ = 0;
 	};
 
-	class VenueWatcher;
-
-	class StateReceiver : public SubSystemServer, Poco::Runnable {
+	class StateReceiver : public SubSystemServer {
 	  public:
 		static auto instance() {
 			static auto instance_ = new StateReceiver;
@@ -31,18 +44,21 @@ namespace OpenWifi {
 
 		int Start() override;
 		void Stop() override;
-		void StateReceived(const std::string &Key, const std::string &Payload);
-		void run() override;
-		void Register(uint64_t SerialNumber, VenueWatcher *VW);
-		void DeRegister(uint64_t SerialNumber, VenueWatcher *VW);
+		void StateReceived(const Types::KafkaIncomingMessagePtr &Msg);
+		void ProcessState(const Types::KafkaIncomingMessagePtr &Msg);
+		void GetStats(Poco::JSON::Object &Obj);
 
 	  private:
-		// map of mac(as int), list of (id,func)
-		std::map<uint64_t, std::list<VenueWatcher *>> Notifiers_;
 		uint64_t StateWatcherId_ = 0;
-		Poco::NotificationQueue Queue_;
-		Poco::Thread Worker_;
-		std::atomic_bool Running_ = false;
+		std::vector<std::unique_ptr<StateReceiverShard>> Shards_;
+		std::atomic_uint64_t Filtered_ = 0;
+		std::atomic_uint64_t Parsed_ = 0;
+		std::atomic_uint64_t ParseErrors_ = 0;
+		std::atomic_uint64_t BytesParsed_ = 0;
+		std::atomic_uint64_t ParseTime_ = 0;
+		std::atomic_uint64_t ArenaAllocations_ = 0;
+		std::atomic_uint64_t ArenaBytes_ = 0;
+		std::atomic_uint64_t ArenaOverflows_ = 0;
 
 		StateReceiver() noexcept
 			: SubSystemServer("StatsReceiver", "STATS-RECEIVER", "stats.receiver") {}
@@ -50,4 +66,4 @@ namespace OpenWifi {
 
 	inline auto StateReceiver() { return StateReceiver::instance(); }
 
-} // namespace OpenWifi
\ No newline at end of file
+} // namespace OpenWifi
@@ -14,6 +14,27 @@
 
 namespace OpenWifi {
 
+	template <typename Record>
+	static typename StorageWriter<Record>::Config
+	WriterConfig(const std::string &Table, typename StorageWriter<Record>::Config C = {}) {
+		auto Get = [&Table](const std::string &Name, uint64_t Default) -> uint64_t {
+			return MicroServiceConfigGetInt(
+				"storage.writer." + Table + "." + Name,
+				MicroServiceConfigGetInt("storage.writer." + Name, Default));
+		};
+		C.threads = Get("threads", C.threads);
+		C.queue_size = Get("queue.size", C.queue_size);
+		C.batch = Get("batch", C.batch);
+		C.window_ms = Get("window", C.window_ms);
+		C.backoff_ms = Get("backoff", C.backoff_ms);
+		C.max_backoff_ms = Get("backoff.max", C.max_backoff_ms);
+		C.policy = OverloadPolicyFromString(MicroServiceConfigGetString(
+			"storage.writer." + Table + ".queue.policy",
+			MicroServiceConfigGetString("storage.writer.queue.policy",
+										OverloadPolicyToString(C.policy))));
+		return C;
+	}
+
 	int Storage::Start() {
 		poco_notice(Logger(), "Starting...");
 		std::lock_guard Guard(Mutex_);
@@ -24,16 +45,54 @@ namespace OpenWifi {
 		TimePointsDB_ = std::make_unique<OpenWifi::TimePointDB>(dbType_, *Pool_, Logger());
 		WifiClientHistoryDB_ =
 			std::make_unique<OpenWifi::WifiClientHistoryDB>(dbType_, *Pool_, Logger());
+		BoardStatsDB_ = std::make_unique<OpenWifi::BoardStatsDB>(dbType_, *Pool_, Logger());
 
 		TimePointsDB_->Create();
 		BoardsDB_->Create();
 		WifiClientHistoryDB_->Create();
+		BoardStatsDB_->Create();
+
+		TimePointCodec::SetEncoding(TimePointCodec::EncodingFromString(
+			MicroServiceConfigGetString("storage.timepoints.encoding", "zlib")));
+
+		auto BatchRows = MicroServiceConfigGetInt("storage.batch.rows", 500);
+		TimePointsDB_->SetBatchRows(BatchRows);
+		WifiClientHistoryDB_->SetBatchRows(BatchRows);
+		auto IngestMode = MicroServiceConfigGetString("storage.ingest.mode", "copy");
+		if (dbType_ == pgsql && IngestMode == "copy")
+			Copy_ = std::make_unique<PostgresCopy>(ConnectionString_, Logger());
+
+		TimePointsWriter_ = std::make_unique<StorageWriter<AnalyticsObjects::DeviceTimePoint>>(
+			"timepoints",
+			[this](const TimePointDB::RecordVec &Records) {
+				return Ingest(*TimePointsDB_, Records);
+			},
+			Logger());
+		TimePointsWriter_->Start(WriterConfig<AnalyticsObjects::DeviceTimePoint>("timepoints"));
+		WifiClientsWriter_ =
+			std::make_unique<StorageWriter<AnalyticsObjects::WifiClientHistory>>(
+				"wificlients",
+				[this](const WifiClientHistoryDB::RecordVec &Records) {
+					return Ingest(*WifiClientHistoryDB_, Records);
+				},
+				Logger());
+		WifiClientsWriter_->Start(
+			WriterConfig<AnalyticsObjects::WifiClientHistory>("wificlienthistory"));
+		BoardStatsWriter_ = std::make_unique<StorageWriter<BoardAggregator::Flush>>(
+			"boardstats", &BoardAggregator::Write, Logger());
+		StorageWriter<BoardAggregator::Flush>::Config BoardStats;
+		BoardStats.policy = OverloadPolicy::coalesce;
+		BoardStatsWriter_->Start(
+			WriterConfig<BoardAggregator::Flush>("boardstats", BoardStats));
 
 		PeriodicCleanup_ = MicroServiceConfigGetInt("storage.cleanup.interval", 6 * 60 * 60);
 		if (PeriodicCleanup_ < 1 * 60 * 60)
 			PeriodicCleanup_ = 1 * 60 * 60;
 
-		Updater_.start(*this);
+		Migrate_ = MicroServiceConfigGetBool("storage.timepoints.migrate", false);
+		Stopping_ = false;
+		if (Migrate_)
+			MaintenanceThread_.start(*this);
 
 		TimerCallback_ = std::make_unique<Poco::TimerCallback<Storage>>(*this, &Storage::onTimer);
 		Timer_.setStartInterval(60 * 1000);						   // first run in 20 seconds
@@ -60,6 +119,7 @@ namespace OpenWifi {
 							fmt::format("Removing old records for board '{}'", board.info.name));
 						BoardsDB().DeleteRecords(fmt::format(" boardId='{}' and timestamp<{}",
 															 board.info.id, lower_bound));
+						BoardStatsDB().DeleteTimeLine(board.info.id, 0, lower_bound - 1);
 					}
 				}
 			}
@@ -76,27 +136,74 @@ namespace OpenWifi {
 											   PeriodicCleanup_));
 	}
 
+	//	Only started, once, when the time point migration is configured.
 	void Storage::run() {
-		Utils::SetThreadName("strg-updtr");
-		Running_ = true;
-		bool FirstRun = true;
-		long Retry = 2000;
-		while (Running_) {
-			if (!FirstRun)
-				Poco::Thread::trySleep(Retry);
-			if (!Running_)
-				break;
-			FirstRun = false;
-			Retry = 2000;
-		}
+		Utils::SetThreadName("strg-maint");
+		if (!Stopping_)
+			MigrateTimePoints();
+	}
+
+	void Storage::GetWriterStats(Poco::JSON::Object &Obj) {
+		Poco::JSON::Object TimePoints, WifiClients, BoardStats;
+		TimePointsWriter_->GetStats(TimePoints);
+		WifiClientsWriter_->GetStats(WifiClients);
+		BoardStatsWriter_->GetStats(BoardStats);
+		Obj.set("timepoints", TimePoints);
+		Obj.set("wificlienthistory", WifiClients);
+		Obj.set("boardstats", BoardStats);
+	}
+
+	void Storage::IngestCounter::GetStats(Poco::JSON::Object &Obj) const {
+		Obj.set("rows", Rows.load());
+		Obj.set("batches", Batches.load());
+		Obj.set("ns", Ns.load());
+		Obj.set("rowsPerSecond", Ns ? Rows * 1000000000 / Ns : 0);
+	}
+
+	void Storage::GetIngestStats(Poco::JSON::Object &Obj) {
+		Obj.set("mode", Copy_ ? "copy" : "insert");
+		Poco::JSON::Object Copied, Inserted;
+		Copied_.GetStats(Copied);
+		Inserted_.GetStats(Inserted);
+		Obj.set("copy", Copied);
+		Obj.set("insert", Inserted);
+		Obj.set("copyFailures", CopyFailures_.load());
+
+		Poco::JSON::Object Codec;
+		TimePointCodec::GetStats(Codec);
+		Obj.set("codec", Codec);
+		Poco::JSON::Object Migration;
+		Migration.set("running", Migrating_.load());
+		Migration.set("rows", Migration_.rows.load());
+		Migration.set("jsonBytes", Migration_.jsonBytes.load());
+		Migration.set("binaryBytes", Migration_.binaryBytes.load());
+		Obj.set("migration", Migration);
+	}
+
+	void Storage::MigrateTimePoints() {
+		auto BatchSize = MicroServiceConfigGetInt("storage.timepoints.migrate.batch", 1000);
+		poco_notice(Logger(), fmt::format("Migrating JSON time points to {}.",
+										  TimePointCodec::EncodingToString(
+											  TimePointCodec::GetEncoding())));
+		Migrating_ = true;
+		auto Done = TimePointsDB_->Migrate(BatchSize, Stopping_, Migration_);
+		Migrating_ = false;
+		poco_notice(Logger(),
+					fmt::format("Time point migration {}: {} rows, {} JSON bytes became {} bytes.",
+								Done && !Stopping_ ? "complete" : "stopped", Migration_.rows.load(),
+								Migration_.jsonBytes.load(), Migration_.binaryBytes.load()));
 	}
 
 	void Storage::Stop() {
 		poco_notice(Logger(), "Stopping...");
-		Running_ = false;
 		Timer_.stop();
-		Updater_.wakeUp();
-		Updater_.join();
+		Stopping_ = true;
+		if (MaintenanceThread_.isRunning())
+			MaintenanceThread_.join();
+		//	Ingest has stopped by now: write out what is still queued.
+		TimePointsWriter_->Stop();
+		WifiClientsWriter_->Stop();
+		BoardStatsWriter_->Stop();
 		poco_notice(Logger(), "Stopped...");
 	}
 } // namespace OpenWifi
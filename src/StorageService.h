@@ -8,10 +8,16 @@
 
 #pragma once
 
+#include "BoardAggregator.h"
 #include "framework/StorageClass.h"
+#include "storage/PostgresCopy.h"
+#include "storage/StorageWriter.h"
+#include "storage/TimePointCodec.h"
 #include "storage/storage_boards.h"
+#include "storage/storage_boardstats.h"
 #include "storage/storage_timepoints.h"
 #include "storage/storage_wificlients.h"
+#include <chrono>
 
 namespace OpenWifi {
 	class Storage : public StorageClass, Poco::Runnable {
@@ -28,17 +34,75 @@ namespace OpenWifi {
 		auto &BoardsDB() { return *BoardsDB_; };
 		auto &TimePointsDB() { return *TimePointsDB_; };
 		auto &WifiClientHistoryDB() { return *WifiClientHistoryDB_; };
+		auto &BoardStatsDB() { return *BoardStatsDB_; };
+		//	Where ingest writes its time points and client history: these never wait for the
+		//	database.
+		auto &TimePointsWriter() { return *TimePointsWriter_; };
+		auto &WifiClientsWriter() { return *WifiClientsWriter_; };
+		auto &BoardStatsWriter() { return *BoardStatsWriter_; };
 		void onTimer(Poco::Timer &timer);
 
+		//	Writes a batch of records: through COPY on PostgreSQL when storage.ingest.mode is copy,
+		//	as multi-row INSERTs otherwise or when COPY fails.
+		template <typename Table> bool Ingest(Table &T, const typename Table::RecordVec &Records) {
+			bool Done = false;
+			if (Copy_) {
+				auto Start = std::chrono::steady_clock::now();
+				typename Table::RecordList Rows(Records.size());
+				for (std::size_t i = 0; i < Records.size(); ++i)
+					T.Convert(Records[i], Rows[i]);
+				Done = Copy_->Copy(T.TableName(), T.SelectFields(), Rows);
+				if (Done)
+					Copied_.Add(Records.size(), Start);
+				else
+					CopyFailures_++;
+			}
+			if (!Done) {
+				auto Start = std::chrono::steady_clock::now();
+				Done = T.CreateRecords(Records);
+				if (Done)
+					Inserted_.Add(Records.size(), Start);
+			}
+			return Done;
+		}
+
+		void GetIngestStats(Poco::JSON::Object &Obj);
+		void GetWriterStats(Poco::JSON::Object &Obj);
+
 	  private:
+		struct IngestCounter {
+			std::atomic_uint64_t Rows = 0, Batches = 0, Ns = 0;
+
+			inline void Add(uint64_t N, std::chrono::steady_clock::time_point Start) {
+				Rows += N;
+				Batches++;
+				Ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  std::chrono::steady_clock::now() - Start)
+						  .count();
+			}
+			void GetStats(Poco::JSON::Object &Obj) const;
+		};
+
 		std::unique_ptr<OpenWifi::BoardsDB> BoardsDB_;
 		std::unique_ptr<OpenWifi::TimePointDB> TimePointsDB_;
 		std::unique_ptr<OpenWifi::WifiClientHistoryDB> WifiClientHistoryDB_;
-		Poco::Thread Updater_;
-		std::atomic_bool Running_ = false;
+		std::unique_ptr<OpenWifi::BoardStatsDB> BoardStatsDB_;
+		std::unique_ptr<StorageWriter<AnalyticsObjects::DeviceTimePoint>> TimePointsWriter_;
+		std::unique_ptr<StorageWriter<AnalyticsObjects::WifiClientHistory>> WifiClientsWriter_;
+		std::unique_ptr<StorageWriter<BoardAggregator::Flush>> BoardStatsWriter_;
+		Poco::Thread MaintenanceThread_;
+		std::atomic_bool Stopping_ = false;
+		bool Migrate_ = false;
+		std::atomic_bool Migrating_ = false;
+		TimePointDB::MigrationStats Migration_;
 		Poco::Timer Timer_;
 		std::unique_ptr<Poco::TimerCallback<Storage>> TimerCallback_;
 		uint64_t PeriodicCleanup_ = 6 * 60 * 60;
+		std::unique_ptr<PostgresCopy> Copy_;
+		IngestCounter Copied_, Inserted_;
+		std::atomic_uint64_t CopyFailures_ = 0;
+
+		void MigrateTimePoints();
 	};
 	inline auto StorageService() { return Storage::instance(); }
 } // namespace OpenWifi
@@ -0,0 +1,122 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/JSON/Object.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OpenWifi {
+
+	//	Interns strings: each distinct string gets a small dense id, and both directions are a
+	//	single hash or array lookup. Entries are never removed, so an id stays valid for the life
+	//	of the process and can be kept in records instead of the string itself.
+	//
+	//	Id 0 is always the empty string. Looking up a string takes a shared lock (an exclusive one
+	//	only the first time it is seen); looking up an id takes no lock at all: strings live in
+	//	fixed size chunks that never move once published.
+	class StringDictionary {
+	  public:
+		static constexpr uint32_t ChunkBits = 10;
+		static constexpr uint32_t ChunkSize = 1 << ChunkBits;
+		static constexpr uint32_t MaxChunks = 4096;
+
+		StringDictionary() {
+			Chunks_[0] = std::make_unique<std::string[]>(ChunkSize);
+			Published_[0].store(Chunks_[0].get(), std::memory_order_release);
+			Size_.store(1, std::memory_order_release);
+		}
+
+		StringDictionary(const StringDictionary &) = delete;
+		StringDictionary &operator=(const StringDictionary &) = delete;
+
+		uint32_t Intern(std::string_view S) {
+			if (S.empty())
+				return 0;
+			{
+				std::shared_lock G(Mutex_);
+				auto It = Ids_.find(S);
+				if (It != Ids_.end())
+					return It->second;
+			}
+
+			std::unique_lock G(Mutex_);
+			auto It = Ids_.find(S);
+			if (It != Ids_.end())
+				return It->second;
+
+			auto Id = Size_.load(std::memory_order_relaxed);
+			auto ChunkId = Id >> ChunkBits;
+			if (ChunkId >= MaxChunks) {
+				Overflows_++;
+				return 0;
+			}
+			if (!Chunks_[ChunkId]) {
+				Chunks_[ChunkId] = std::make_unique<std::string[]>(ChunkSize);
+				Published_[ChunkId].store(Chunks_[ChunkId].get(), std::memory_order_release);
+			}
+			auto &Entry = Chunks_[ChunkId][Id & (ChunkSize - 1)];
+			Entry.assign(S.data(), S.size());
+			Bytes_ += Entry.size();
+			Ids_.emplace(std::string_view(Entry), Id);
+			Size_.store(Id + 1, std::memory_order_release);
+			return Id;
+		}
+
+		//	Unknown ids give the empty string.
+		inline const std::string &Get(uint32_t Id) const {
+			if (Id >= Size_.load(std::memory_order_acquire))
+				return Chunks_[0][0];
+			return Published_[Id >> ChunkBits].load(std::memory_order_acquire)[Id & (ChunkSize - 1)];
+		}
+
+		inline uint32_t Size() const { return Size_.load(std::memory_order_acquire); }
+
+		void GetStats(Poco::JSON::Object &Obj) {
+			Obj.set("entries", Size() - 1);
+			Obj.set("bytes", Bytes_.load());
+			Obj.set("overflows", Overflows_.load());
+		}
+
+	  private:
+		std::shared_mutex Mutex_;
+		std::unordered_map<std::string_view, uint32_t> Ids_;
+		std::array<std::unique_ptr<std::string[]>, MaxChunks> Chunks_;
+		std::array<std::atomic<std::string *>, MaxChunks> Published_{};
+		std::atomic_uint32_t Size_ = 0;
+		std::atomic_uint64_t Bytes_ = 0;
+		std::atomic_uint64_t Overflows_ = 0;
+	};
+
+	inline StringDictionary *SSIDDictionary() {
+		static auto instance_ = new StringDictionary;
+		return instance_;
+	}
+
+	//	An SSID kept as its id in SSIDDictionary(). Thousands of APs broadcast the same handful
+	//	of SSIDs, so records hold 4 bytes instead of their own copy of the name.
+	class SSIDName {
+	  public:
+		SSIDName() = default;
+		explicit SSIDName(std::string_view S) : Id_(SSIDDictionary()->Intern(S)) {}
+
+		[[nodiscard]] inline const std::string &str() const { return SSIDDictionary()->Get(Id_); }
+		[[nodiscard]] inline uint32_t Id() const { return Id_; }
+		[[nodiscard]] inline bool Empty() const { return Id_ == 0; }
+
+		inline bool operator==(const SSIDName &R) const { return Id_ == R.Id_; }
+		inline bool operator!=(const SSIDName &R) const { return Id_ != R.Id_; }
+
+	  private:
+		uint32_t Id_ = 0;
+	};
+
+} // namespace OpenWifi
@@ -0,0 +1,123 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "TimePointRing.h"
+#include <algorithm>
+
+namespace OpenWifi {
+
+	void TimePointRing::Configure(const Limits &L) {
+		std::lock_guard G(Mutex_);
+		Limits_ = L;
+		Trim();
+	}
+
+	void TimePointRing::Add(const AnalyticsObjects::DeviceTimePoint &P) {
+		std::lock_guard G(Mutex_);
+		if (Limits_.window == 0)
+			return;
+		//	Earlier points of this AP can only be older than its first one.
+		if (!Started_) {
+			From_ = P.timestamp;
+			Started_ = true;
+		} else if (!Points_.empty() && P.timestamp < Points_.back().second.timestamp) {
+			//	The clock went backwards: the database still holds the points up to the previous
+			//	newest one, so the ring only answers for what comes after it.
+			From_ = std::max(From_, Points_.back().second.timestamp + 1);
+			Points_.clear();
+			Bytes_ = 0;
+		}
+		auto Size = Footprint(P);
+		Points_.emplace_back(Size, P);
+		Bytes_ += Size;
+		Trim();
+	}
+
+	void TimePointRing::Clear() {
+		std::lock_guard G(Mutex_);
+		Points_.clear();
+		Bytes_ = 0;
+		From_ = Utils::Now();
+		Started_ = false;
+	}
+
+	void TimePointRing::Evict() {
+		From_ = std::max(From_, Points_.front().second.timestamp + 1);
+		Bytes_ -= Points_.front().first;
+		Points_.pop_front();
+	}
+
+	void TimePointRing::Trim() {
+		if (Limits_.window == 0) {
+			Points_.clear();
+			Bytes_ = 0;
+			From_ = UINT64_MAX;
+			return;
+		}
+		while (!Points_.empty()) {
+			const auto &Oldest = Points_.front().second;
+			if ((Limits_.max_points && Points_.size() > Limits_.max_points) ||
+				(Limits_.max_bytes && Bytes_ > Limits_.max_bytes) ||
+				Oldest.timestamp + Limits_.window < Points_.back().second.timestamp)
+				Evict();
+			else
+				break;
+		}
+	}
+
+	static auto ByTimestamp = [](const auto &Entry, uint64_t ts) {
+		return Entry.second.timestamp < ts;
+	};
+
+	void TimePointRing::Get(uint64_t from, uint64_t end,
+							std::vector<AnalyticsObjects::DeviceTimePoint> &Points) const {
+		std::lock_guard G(Mutex_);
+		for (auto It = std::lower_bound(Points_.begin(), Points_.end(), from, ByTimestamp);
+			 It != Points_.end() && (end == 0 || It->second.timestamp <= end); ++It)
+			Points.push_back(It->second);
+	}
+
+	bool TimePointRing::Latest(uint64_t from, uint64_t end,
+							   AnalyticsObjects::DeviceTimePoint &Point) const {
+		std::lock_guard G(Mutex_);
+		auto It = end == 0 ? Points_.end()
+						   : std::lower_bound(Points_.begin(), Points_.end(), end + 1, ByTimestamp);
+		if (It == Points_.begin())
+			return false;
+		--It;
+		if (It->second.timestamp < from)
+			return false;
+		Point = It->second;
+		return true;
+	}
+
+	uint64_t TimePointRing::From() const {
+		std::lock_guard G(Mutex_);
+		return From_;
+	}
+
+	uint64_t TimePointRing::Points() const {
+		std::lock_guard G(Mutex_);
+		return Points_.size();
+	}
+
+	uint64_t TimePointRing::Bytes() const {
+		std::lock_guard G(Mutex_);
+		return Bytes_;
+	}
+
+	//	An estimate of the heap a point holds: its vectors and the larger strings.
+	uint64_t TimePointRing::Footprint(const AnalyticsObjects::DeviceTimePoint &P) {
+		uint64_t Bytes = sizeof(P) + P.radio_data.capacity() * sizeof(P.radio_data[0]) +
+						 P.ssid_data.capacity() * sizeof(P.ssid_data[0]);
+		for (const auto &ssid : P.ssid_data) {
+			Bytes += ssid.associations.capacity() * sizeof(ssid.associations[0]);
+			for (const auto &association : ssid.associations)
+				Bytes += association.fingerprint.json.capacity() +
+						 association.tidstats.capacity() * sizeof(association.tidstats[0]);
+		}
+		return Bytes;
+	}
+
+} // namespace OpenWifi
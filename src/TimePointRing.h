@@ -0,0 +1,59 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include "framework/utils.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace OpenWifi {
+
+	//	The most recent time points of one AP, exactly as they were written to the database, so
+	//	that queries on the last hours can be answered without reading them back.
+	//
+	//	From() is the oldest timestamp the ring is complete from: any point the database holds
+	//	for this AP at or after From() is also in the ring. It starts at the first point added and
+	//	moves forward as points are evicted.
+	class TimePointRing {
+	  public:
+		struct Limits {
+			uint64_t window = 86400; //	seconds, 0 keeps nothing
+			uint64_t max_points = 0; //	0 for no limit
+			uint64_t max_bytes = 0;	 //	0 for no limit
+		};
+
+		TimePointRing() : From_(Utils::Now()) {}
+
+		void Configure(const Limits &L);
+		void Add(const AnalyticsObjects::DeviceTimePoint &P);
+		//	Forget everything, as if the AP had just been added.
+		void Clear();
+
+		//	Points with from <= timestamp <= end, oldest first. end == 0 means no upper bound.
+		void Get(uint64_t from, uint64_t end,
+				 std::vector<AnalyticsObjects::DeviceTimePoint> &Points) const;
+		bool Latest(uint64_t from, uint64_t end, AnalyticsObjects::DeviceTimePoint &Point) const;
+
+		uint64_t From() const;
+		uint64_t Points() const;
+		uint64_t Bytes() const;
+
+		static uint64_t Footprint(const AnalyticsObjects::DeviceTimePoint &P);
+
+	  private:
+		mutable std::mutex Mutex_;
+		Limits Limits_;
+		std::deque<std::pair<uint64_t, AnalyticsObjects::DeviceTimePoint>> Points_;
+		uint64_t Bytes_ = 0;
+		uint64_t From_ = 0;
+		bool Started_ = false;
+
+		void Trim();
+		void Evict();
+	};
+
+} // namespace OpenWifi
@@ -8,11 +8,17 @@
 #include "fmt/core.h"
 #include "framework/MicroServiceFuncs.h"
 #include "sdks/SDK_prov.h"
+#include <thread>
 
 namespace OpenWifi {
 
 	int VenueCoordinator::Start() {
 		poco_notice(Logger(), "Starting...");
+		auto NumberOfThreads = MicroServiceConfigGetInt("venue.coordinator.workers", 0);
+		if (NumberOfThreads == 0)
+			NumberOfThreads = std::thread::hardware_concurrency();
+		Executor_.Start(NumberOfThreads);
+		poco_notice(Logger(), fmt::format("Boards share {} worker threads.", Executor_.Threads()));
 		GetBoardList();
 		Worker_.start(*this);
 
@@ -53,6 +59,13 @@ namespace OpenWifi {
 		Worker_.wakeUp();
 		Worker_.wakeUp();
 		Worker_.join();
+		{
+			std::lock_guard G(Mutex_);
+			for (auto &[board_id, watcher] : Watchers_)
+				watcher->Stop();
+			Watchers_.clear();
+		}
+		Executor_.Stop();
 		poco_notice(Logger(), "Stopped...");
 	}
 
@@ -86,9 +99,10 @@ namespace OpenWifi {
 		Logger().error(fmt::format(
 			"Venue board '{}' is no longer in the system. Retiring its associated board.",
 			B.venueList[0].name));
-		StopBoard(B.info.id);
+		StopBoard(B.info.id, true);
 		StorageService()->BoardsDB().DeleteRecord("id", B.info.id);
 		StorageService()->TimePointsDB().DeleteRecords(fmt::format(" boardId='{}' ", B.info.id));
+		StorageService()->BoardStatsDB().DeleteBoard(B.info.id);
 	}
 
 	bool VenueCoordinator::GetDevicesForBoard(const AnalyticsObjects::BoardInfo &B,
@@ -124,7 +138,8 @@ namespace OpenWifi {
 			std::lock_guard G(Mutex_);
 			ExistingBoards_[B.info.id] = Devices;
 			Watchers_[B.info.id] =
-				std::make_shared<VenueWatcher>(B.info.id, B.venueList[0].id, Logger(), Devices);
+				std::make_shared<VenueWatcher>(B.info.id, B.venueList[0], Logger(), Devices,
+											   Executor_);
 			Watchers_[B.info.id]->Start();
 			poco_information(Logger(), fmt::format("Started board {} for venue {}", B.info.name,
 												   B.venueList[0].id));
@@ -140,12 +155,12 @@ namespace OpenWifi {
 		return false;
 	}
 
-	void VenueCoordinator::StopBoard(const std::string &id) {
+	void VenueCoordinator::StopBoard(const std::string &id, bool Deleted) {
 		std::lock_guard G(Mutex_);
 
 		auto it = Watchers_.find(id);
 		if (it != Watchers_.end()) {
-			it->second->Stop();
+			it->second->Stop(Deleted);
 			Watchers_.erase(it);
 		}
 	}
@@ -206,4 +221,104 @@ namespace OpenWifi {
 			it->second->GetDevices(DIL.devices);
 		}
 	}
-} // namespace OpenWifi
\ No newline at end of file
+
+	std::shared_ptr<VenueWatcher> VenueCoordinator::GetWatcher(const std::string &id) {
+		std::lock_guard G(Mutex_);
+		auto it = Watchers_.find(id);
+		if (it == Watchers_.end())
+			return nullptr;
+		return it->second;
+	}
+
+	bool VenueCoordinator::GetBandwidth(const std::string &id, uint64_t start, uint64_t end,
+										uint64_t interval,
+										AnalyticsObjects::BandwidthAnalysis &BW) {
+		auto Watcher = GetWatcher(id);
+		if (!Watcher)
+			return false;
+		Watcher->GetBandwidth(start, end, interval, BW);
+		return true;
+	}
+
+	bool VenueCoordinator::GetTimePoints(const std::string &id, uint64_t FromDate,
+										 uint64_t LastDate, uint64_t MaxRecords,
+										 bool LatestPerDevice,
+										 std::vector<AnalyticsObjects::DeviceTimePoint> &Points) {
+		auto Watcher = GetWatcher(id);
+		if (Watcher &&
+			Watcher->GetTimePoints(FromDate, LastDate, MaxRecords, LatestPerDevice, Points)) {
+			TimePointsFromMemory_++;
+			return true;
+		}
+		TimePointsFromDatabase_++;
+		return false;
+	}
+
+	void VenueCoordinator::ClearTimePoints(const std::string &id) {
+		auto Watcher = GetWatcher(id);
+		if (Watcher)
+			Watcher->ClearTimePoints();
+	}
+
+	bool VenueCoordinator::GetBoardStats(
+		const std::string &id, uint64_t FromDate, uint64_t LastDate, uint64_t MaxRecords,
+		std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats) {
+		auto Watcher = GetWatcher(id);
+		if (Watcher)
+			return Watcher->GetBoardStats(FromDate, LastDate, MaxRecords, Stats);
+		return BoardAggregator::GetStored(id, FromDate, LastDate, MaxRecords, Stats);
+	}
+
+	void VenueCoordinator::GetStats(Poco::JSON::Object &Obj) {
+		std::lock_guard G(Mutex_);
+
+		Poco::JSON::Array Boards;
+		uint64_t TotalDepth = 0, Dropped = 0, BlockedNs = 0, Superseded = 0, HotPoints = 0,
+				 HotBytes = 0, OpenBuckets = 0, PendingBuckets = 0, FlushedBuckets = 0;
+		for (const auto &[board_id, watcher] : Watchers_) {
+			Poco::JSON::Object BoardObj;
+			auto &Queue = watcher->Queue();
+			Queue.GetStats(BoardObj);
+			TotalDepth += Queue.Size();
+			Dropped += Queue.Dropped();
+			BlockedNs += Queue.BlockedNs();
+			Superseded += watcher->StatesSuperseded();
+			BoardObj.set("boardId", board_id);
+			BoardObj.set("drains", watcher->Drains());
+			BoardObj.set("statesSuperseded", watcher->StatesSuperseded());
+			uint64_t Points = 0, Bytes = 0;
+			watcher->TimePointStats(Points, Bytes);
+			HotPoints += Points;
+			HotBytes += Bytes;
+			BoardObj.set("hotPoints", Points);
+			BoardObj.set("hotBytes", Bytes);
+			auto &Aggregates = watcher->Aggregates();
+			OpenBuckets += Aggregates.OpenBuckets();
+			PendingBuckets += Aggregates.PendingBuckets();
+			FlushedBuckets += Aggregates.Flushed();
+			BoardObj.set("openBuckets", Aggregates.OpenBuckets());
+			BoardObj.set("pendingBuckets", Aggregates.PendingBuckets());
+			BoardObj.set("flushedBuckets", Aggregates.Flushed());
+			Boards.add(BoardObj);
+		}
+		Obj.set("boards", Watchers_.size());
+		Obj.set("queueDepth", TotalDepth);
+		Obj.set("dropped", Dropped);
+		Obj.set("blockedNs", BlockedNs);
+		Obj.set("statesSuperseded", Superseded);
+		Obj.set("hotPoints", HotPoints);
+		Obj.set("hotBytes", HotBytes);
+		Obj.set("openBuckets", OpenBuckets);
+		Obj.set("pendingBuckets", PendingBuckets);
+		Obj.set("flushedBuckets", FlushedBuckets);
+		Obj.set("timepointsFromMemory", TimePointsFromMemory_.load());
+		Obj.set("timepointsFromDatabase", TimePointsFromDatabase_.load());
+		Obj.set("watchers", Boards);
+		Obj.set("nodesAllocated", Mailbox<VenueMessage>::Pool().Allocated());
+		Obj.set("nodesReused", Mailbox<VenueMessage>::Pool().Reused());
+
+		Poco::JSON::Object ExecutorObj;
+		Executor_.GetStats(ExecutorObj);
+		Obj.set("executor", ExecutorObj);
+	}
+} // namespace OpenWifi
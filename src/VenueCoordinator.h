@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Executor.h"
 #include "VenueWatcher.h"
 #include "framework/SubSystemServer.h"
 
@@ -22,16 +23,30 @@ namespace OpenWifi {
 		void Stop() override;
 		void run() override;
 
-		void StopBoard(const std::string &id);
+		//	Deleted boards discard their statistics not yet written.
+		void StopBoard(const std::string &id, bool Deleted = false);
 		void UpdateBoard(const std::string &id);
 		void AddBoard(const std::string &id);
 
 		bool GetDevicesForBoard(const AnalyticsObjects::BoardInfo &B,
 								std::vector<uint64_t> &Devices, bool &VenueExists);
 		void GetDevices(std::string &id, AnalyticsObjects::DeviceInfoList &DIL);
+		bool GetBandwidth(const std::string &id, uint64_t start, uint64_t end, uint64_t interval,
+						  AnalyticsObjects::BandwidthAnalysis &BW);
+		//	Returns false when the board's recent time points do not cover the range: the caller
+		//	must then read the database.
+		bool GetTimePoints(const std::string &id, uint64_t FromDate, uint64_t LastDate,
+						   uint64_t MaxRecords, bool LatestPerDevice,
+						   std::vector<AnalyticsObjects::DeviceTimePoint> &Points);
+		void ClearTimePoints(const std::string &id);
+		//	Precomputed per bucket statistics. Returns false when none cover the range.
+		bool GetBoardStats(const std::string &id, uint64_t FromDate, uint64_t LastDate,
+						   uint64_t MaxRecords,
+						   std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats);
 		void GetBoardList();
 		bool Watching(const std::string &id);
 		void RetireBoard(const AnalyticsObjects::BoardInfo &B);
+		void GetStats(Poco::JSON::Object &Obj);
 
 		void onReconcileTimer(Poco::Timer &timer);
 
@@ -42,6 +57,9 @@ namespace OpenWifi {
 		std::map<std::string, std::shared_ptr<VenueWatcher>> Watchers_;
 		std::unique_ptr<Poco::TimerCallback<VenueCoordinator>> ReconcileTimerCallback_;
 		Poco::Timer ReconcileTimerTimer_;
+		Executor Executor_{"venue-exec"};
+		std::atomic_uint64_t TimePointsFromMemory_ = 0;
+		std::atomic_uint64_t TimePointsFromDatabase_ = 0;
 
 		std::map<std::string, std::vector<uint64_t>> ExistingBoards_;
 
@@ -49,6 +67,7 @@ namespace OpenWifi {
 			: SubSystemServer("VenueCoordinator", "VENUE-COORD", "venue.coordinator") {}
 
 		bool StartBoard(const AnalyticsObjects::BoardInfo &B);
+		std::shared_ptr<VenueWatcher> GetWatcher(const std::string &id);
 	};
 	inline auto VenueCoordinator() { return VenueCoordinator::instance(); }
 
@@ -3,84 +3,127 @@
 //
 
 #include "VenueWatcher.h"
-#include "DeviceStatusReceiver.h"
-#include "HealthReceiver.h"
-#include "StateReceiver.h"
+#include "DeviceRegistry.h"
+#include "framework/MicroServiceFuncs.h"
+#include "framework/utils.h"
 
 namespace OpenWifi {
 
 	void VenueWatcher::Start() {
 		poco_notice(Logger(), "Starting...");
+		Queue_.Configure(MicroServiceConfigGetInt("venue.watcher.queue.size", 1000),
+						 OverloadPolicyFromString(
+							 MicroServiceConfigGetString("venue.watcher.queue.policy", "block")));
+		Budget_ = MicroServiceConfigGetInt("venue.watcher.budget", 64);
+		if (Budget_ < 1)
+			Budget_ = 1;
+		Bandwidth_.Configure(MicroServiceConfigGetInt("venue.bandwidth.bucket", 60),
+							 MicroServiceConfigGetInt("venue.bandwidth.retention", 86400));
+		uint64_t StatsBucket = MicroServiceConfigGetInt("venue.aggregates.bucket", 0);
+		Aggregates_.Configure(StatsBucket ? StatsBucket : Interval_);
 		{
 			std::lock_guard G(Mutex_);
 			for (const auto &mac : SerialNumbers_) {
 				auto ap = std::make_shared<AP>(mac, venue_id_, boardId_, Logger());
 				APs_[mac] = ap;
 			}
+			SetTimePointLimits();
 		}
 
-		for (const auto &i : SerialNumbers_)
-			StateReceiver()->Register(i, this);
-
-		DeviceStatusReceiver()->Register(SerialNumbers_, this);
-		HealthReceiver()->Register(SerialNumbers_, this);
-		Worker_.start(*this);
+		DeviceRegistry()->Register(SerialNumbers_, shared_from_this());
 	}
 
-	void VenueWatcher::Stop() {
+	void VenueWatcher::Stop(bool Deleted) {
 		poco_notice(Logger(), "Stopping...");
-		Running_ = false;
-		Queue_.wakeUpAll();
-		Worker_.join();
-		for (const auto &i : SerialNumbers_)
-			StateReceiver()->DeRegister(i, this);
-		DeviceStatusReceiver()->DeRegister(this);
-		HealthReceiver()->DeRegister(this);
+		DeviceRegistry()->DeRegister(SerialNumbers_, this);
+		Queue_.Shutdown();
+		//	Wait for a drain in progress on the executor.
+		std::lock_guard G(DrainMutex_);
+		if (Deleted)
+			Aggregates_.Discard();
+		else
+			Aggregates_.Close();
 		poco_notice(Logger(), "Stopped...");
 	}
 
 	void VenueWatcher::run() {
-		Utils::SetThreadName("venue-watch");
-		Running_ = true;
-		Poco::AutoPtr<Poco::Notification> Msg(Queue_.waitDequeueNotification());
-		while (Msg && Running_) {
-			auto MsgContent = dynamic_cast<VenueMessage *>(Msg.get());
-			if (MsgContent != nullptr) {
-				try {
-					std::shared_ptr<AP> ap;
-					{
-						std::lock_guard G(Mutex_);
-						auto It = APs_.find(MsgContent->SerialNumber());
-						if (It != end(APs_)) {
-							ap = It->second;
-						}
-					}
-
-					if (ap) {
-						switch (MsgContent->Type()) {
-							case VenueMessage::connection:
-								ap->UpdateConnection(MsgContent->Payload());
-								break;
-							case VenueMessage::state:
-								ap->UpdateStats(MsgContent->Payload());
-								break;
-							case VenueMessage::health:
-								ap->UpdateHealth(MsgContent->Payload());
-								break;
-							default:
-								break;
-						}
-					}
-				} catch (const Poco::Exception &E) {
-					Logger().log(E);
-				} catch (...) {
+		{
+			std::lock_guard G(DrainMutex_);
+			VenueMessage Msg;
+			for (uint64_t Done = 0; Done < Budget_ && Queue_.TryPop(Msg); ++Done) {
+				Process(Msg);
+				Msg = VenueMessage();
+			}
+			//	The mailbox may have dropped the only message of a pending report.
+			if (Queue_.Dropped() != DroppedSeen_) {
+				DroppedSeen_ = Queue_.Dropped();
+				RepostPendingStates();
+			}
+			Drains_++;
+		}
+		//	Anything posted after the last TryPop either sees Scheduled_ cleared and reschedules
+		//	itself, or is caught by the check below.
+		Scheduled_ = false;
+		if (!Queue_.Empty())
+			Schedule();
+	}
+
+	void VenueWatcher::Process(VenueMessage &Msg) {
+		try {
+			std::shared_ptr<AP> ap;
+			{
+				std::lock_guard G(Mutex_);
+				auto It = APs_.find(Msg.SerialNumber());
+				if (It != end(APs_)) {
+					ap = It->second;
+				}
+			}
+
+			if (ap) {
+				switch (Msg.Type()) {
+					case VenueMessage::connection:
+						ap->UpdateConnection(Msg.Payload());
+						break;
+					case VenueMessage::state: {
+						//	Empty when an earlier message already processed the newest report.
+						auto Report = TakePendingState(Msg.SerialNumber());
+						if (Report && ap->UpdateStats(Report, Aggregates_))
+							Bandwidth_.Add(Msg.SerialNumber(), ap->LastSample());
+					} break;
+					case VenueMessage::health:
+						ap->UpdateHealth(Msg.Payload());
+						break;
+					default:
+						break;
 				}
-			} else {
 			}
-			Msg = Queue_.waitDequeueNotification();
+		} catch (const Poco::Exception &E) {
+			Logger().log(E);
+		} catch (...) {
 		}
 	}
 
+	std::shared_ptr<StateReport> VenueWatcher::TakePendingState(uint64_t SerialNumber) {
+		std::lock_guard G(PendingMutex_);
+		auto It = PendingStates_.find(SerialNumber);
+		if (It == PendingStates_.end())
+			return nullptr;
+		auto Report = std::move(It->second);
+		PendingStates_.erase(It);
+		return Report;
+	}
+
+	void VenueWatcher::RepostPendingStates() {
+		std::vector<uint64_t> SerialNumbers;
+		{
+			std::lock_guard G(PendingMutex_);
+			for (const auto &[SerialNumber, Report] : PendingStates_)
+				SerialNumbers.push_back(SerialNumber);
+		}
+		for (auto SerialNumber : SerialNumbers)
+			Post(VenueMessage(SerialNumber, VenueMessage::state));
+	}
+
 	void VenueWatcher::ModifySerialNumbers(const std::vector<uint64_t> &SerialNumbers) {
 		std::lock_guard G(Mutex_);
 
@@ -98,17 +141,19 @@ namespace OpenWifi {
 							  std::inserter(ToAdd, ToAdd.begin()));
 
 		for (const auto &i : ToRemove) {
-			StateReceiver()->DeRegister(i, this);
 			APs_.erase(i);
+			TakePendingState(i);
 		}
+		//	The database still holds the points of removed APs, which no ring has any more.
+		if (!ToRemove.empty())
+			RingsFrom_ = Utils::Now() + 1;
 		for (const auto &i : ToAdd) {
-			StateReceiver()->Register(i, this);
 			auto ap = std::make_shared<AP>(i, venue_id_, boardId_, Logger());
 			APs_[i] = ap;
 		}
+		SetTimePointLimits();
 
-		HealthReceiver()->Register(SerialNumbers, this);
-		DeviceStatusReceiver()->Register(SerialNumbers, this);
+		DeviceRegistry()->Modify(ToRemove, ToAdd, shared_from_this());
 
 		SerialNumbers_ = SerialNumbers;
 	}
@@ -121,4 +166,93 @@ namespace OpenWifi {
 			DIL.push_back(DI->Info());
 	}
 
+	//	The board's memory budget is shared evenly between its APs. Called with Mutex_ held.
+	void VenueWatcher::SetTimePointLimits() {
+		TimePointRing::Limits L;
+		L.window = MicroServiceConfigGetInt("venue.timepoints.hot.window", 86400);
+		if (Retention_ && Retention_ < L.window)
+			L.window = Retention_;
+		if (Interval_)
+			L.max_points = L.window / Interval_ + 1;
+		uint64_t Memory = MicroServiceConfigGetInt("venue.timepoints.hot.memory", 64) * 1024 * 1024;
+		if (!APs_.empty())
+			L.max_bytes = std::max<uint64_t>(Memory / APs_.size(), 1);
+		for (const auto &[serialNumber, ap] : APs_)
+			ap->TimePoints().Configure(L);
+	}
+
+	bool VenueWatcher::GetTimePoints(uint64_t FromDate, uint64_t LastDate, uint64_t MaxRecords,
+									 bool LatestPerDevice,
+									 std::vector<AnalyticsObjects::DeviceTimePoint> &Points) {
+		if (FromDate == 0)
+			return false;
+
+		std::vector<std::shared_ptr<AP>> APs;
+		uint64_t RingsFrom;
+		{
+			std::lock_guard G(Mutex_);
+			APs.reserve(APs_.size());
+			for (const auto &[serialNumber, ap] : APs_)
+				APs.push_back(ap);
+			RingsFrom = RingsFrom_;
+		}
+
+		auto Covered = [&] {
+			return RingsFrom <= FromDate &&
+				   std::all_of(APs.begin(), APs.end(), [FromDate](const auto &ap) {
+					   return ap->TimePoints().From() <= FromDate;
+				   });
+		};
+		if (!Covered())
+			return false;
+
+		std::vector<AnalyticsObjects::DeviceTimePoint> Found;
+		if (LatestPerDevice) {
+			for (const auto &ap : APs) {
+				AnalyticsObjects::DeviceTimePoint P;
+				if (ap->TimePoints().Latest(FromDate, LastDate, P))
+					Found.push_back(std::move(P));
+			}
+			std::sort(Found.begin(), Found.end(),
+					  [](const auto &a, const auto &b) { return a.timestamp > b.timestamp; });
+		} else {
+			for (const auto &ap : APs)
+				ap->TimePoints().Get(FromDate, LastDate, Found);
+			std::sort(Found.begin(), Found.end());
+		}
+		if (Found.size() > MaxRecords)
+			Found.resize(MaxRecords);
+
+		//	Points evicted while we were copying would be missing.
+		if (!Covered())
+			return false;
+		Points.swap(Found);
+		return true;
+	}
+
+	void VenueWatcher::ClearTimePoints() {
+		std::lock_guard G(Mutex_);
+		for (const auto &[serialNumber, ap] : APs_)
+			ap->TimePoints().Clear();
+	}
+
+	void VenueWatcher::TimePointStats(uint64_t &Points, uint64_t &Bytes) {
+		std::lock_guard G(Mutex_);
+		for (const auto &[serialNumber, ap] : APs_) {
+			Points += ap->TimePoints().Points();
+			Bytes += ap->TimePoints().Bytes();
+		}
+	}
+
+	bool VenueWatcher::GetBoardStats(
+		uint64_t FromDate, uint64_t LastDate, uint64_t MaxRecords,
+		std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats) {
+		return Aggregates_.Get(FromDate, LastDate, MaxRecords, Stats);
+	}
+
+	void VenueWatcher::GetBandwidth(uint64_t start, uint64_t end, uint64_t interval,
+									AnalyticsObjects::BandwidthAnalysis &BW) {
+		Bandwidth_.Get(start, end, interval, BW);
+	}
+
 } // namespace OpenWifi
\ No newline at end of file
@@ -5,58 +5,80 @@
 #pragma once
 
 #include "APStats.h"
-#include "Poco/Notification.h"
-#include "Poco/NotificationQueue.h"
+#include "Executor.h"
+#include "Mailbox.h"
 #include "RESTObjects/RESTAPI_AnalyticsObjects.h"
 #include "framework/SubSystemServer.h"
+#include <unordered_map>
 
 namespace OpenWifi {
 
-	class VenueMessage : public Poco::Notification {
+	class VenueMessage {
 	  public:
 		enum MsgType { connection, state, health };
 
+		VenueMessage() = default;
 		explicit VenueMessage(uint64_t SerialNumber, MsgType Msg,
 							  std::shared_ptr<nlohmann::json> &M)
 			: Payload_(M), Type_(Msg), SerialNumber_(SerialNumber) {}
+		explicit VenueMessage(uint64_t SerialNumber, MsgType Msg)
+			: Type_(Msg), SerialNumber_(SerialNumber) {}
 		inline std::shared_ptr<nlohmann::json> &Payload() { return Payload_; }
 		inline auto SerialNumber() { return SerialNumber_; }
 		inline uint64_t Type() { return Type_; }
 
 	  private:
 		std::shared_ptr<nlohmann::json> Payload_;
-		MsgType Type_;
+		MsgType Type_ = connection;
 		uint64_t SerialNumber_ = 0;
 	};
 
-	class VenueWatcher : public Poco::Runnable {
+	//	A board does not own a thread: its queue is drained on the executor shared by all boards,
+	//	at most Budget_ messages at a time, and never by two threads at once, so messages for a
+	//	board are still processed in order.
+	class VenueWatcher : public Poco::Runnable,
+						 public std::enable_shared_from_this<VenueWatcher> {
 	  public:
-		explicit VenueWatcher(const std::string &boardId, const std::string &venue_id,
-							  Poco::Logger &L, const std::vector<uint64_t> &SerialNumbers)
-			: boardId_(boardId), venue_id_(venue_id), Logger_(L), SerialNumbers_(SerialNumbers) {
+		explicit VenueWatcher(const std::string &boardId, const AnalyticsObjects::VenueInfo &Venue,
+							  Poco::Logger &L, const std::vector<uint64_t> &SerialNumbers,
+							  Executor &E)
+			: boardId_(boardId), venue_id_(Venue.id), Logger_(L), Executor_(E),
+			  Interval_(Venue.interval), Retention_(Venue.retention),
+			  SerialNumbers_(SerialNumbers), Aggregates_(boardId) {
 			std::sort(SerialNumbers_.begin(), SerialNumbers_.end());
 			auto last = std::unique(SerialNumbers_.begin(), SerialNumbers_.end());
 			SerialNumbers_.erase(last, SerialNumbers_.end());
 		}
 
-		inline void PostState(uint64_t SerialNumber, std::shared_ptr<nlohmann::json> &Msg) {
-			std::lock_guard G(Mutex_);
-			Queue_.enqueueNotification(new VenueMessage(SerialNumber, VenueMessage::state, Msg));
+		//	Posting never takes the board's lock: the mailbox is lock-free.
+		//	State reports carry cumulative counters, so only the newest one per device matters: it
+		//	goes into the device's pending slot, replacing any report not yet processed, and the
+		//	queued message only tells the worker to look at that slot. A report that replaces
+		//	another one does not queue a message: the one already queued picks it up.
+		inline void PostState(uint64_t SerialNumber, const std::shared_ptr<StateReport> &Report) {
+			bool Fresh;
+			{
+				std::lock_guard G(PendingMutex_);
+				auto &Slot = PendingStates_[SerialNumber];
+				Fresh = !Slot;
+				if (!Fresh)
+					StatesSuperseded_++;
+				Slot = Report;
+			}
+			if (Fresh)
+				Post(VenueMessage(SerialNumber, VenueMessage::state));
 		}
 
 		inline void PostConnection(uint64_t SerialNumber, std::shared_ptr<nlohmann::json> &Msg) {
-			std::lock_guard G(Mutex_);
-			Queue_.enqueueNotification(
-				new VenueMessage(SerialNumber, VenueMessage::connection, Msg));
+			Post(VenueMessage(SerialNumber, VenueMessage::connection, Msg));
 		}
 
 		inline void PostHealth(uint64_t SerialNumber, std::shared_ptr<nlohmann::json> &Msg) {
-			std::lock_guard G(Mutex_);
-			Queue_.enqueueNotification(new VenueMessage(SerialNumber, VenueMessage::health, Msg));
+			Post(VenueMessage(SerialNumber, VenueMessage::health, Msg));
 		}
 
 		void Start();
-		void Stop();
+		void Stop(bool Deleted = false);
 
 		void run() final;
 		inline Poco::Logger &Logger() { return Logger_; }
@@ -65,18 +87,58 @@ namespace OpenWifi {
 
 		void GetBandwidth(uint64_t start, uint64_t end, uint64_t interval,
 						  AnalyticsObjects::BandwidthAnalysis &BW);
+		bool GetTimePoints(uint64_t FromDate, uint64_t LastDate, uint64_t MaxRecords,
+						   bool LatestPerDevice,
+						   std::vector<AnalyticsObjects::DeviceTimePoint> &Points);
+		void ClearTimePoints();
+		void TimePointStats(uint64_t &Points, uint64_t &Bytes);
+		bool GetBoardStats(uint64_t FromDate, uint64_t LastDate, uint64_t MaxRecords,
+						   std::vector<AnalyticsObjects::DeviceTimePointAnalysis> &Stats);
+		inline auto &Aggregates() { return Aggregates_; }
 		inline std::string Venue() const { return venue_id_; }
+		inline auto &Queue() { return Queue_; }
+		inline uint64_t StatesSuperseded() const { return StatesSuperseded_; }
+		inline uint64_t Drains() const { return Drains_; }
 
 	  private:
 		std::mutex Mutex_;
 		std::string boardId_;
 		std::string venue_id_;
-		Poco::NotificationQueue Queue_;
+		Mailbox<VenueMessage> Queue_;
 		Poco::Logger &Logger_;
-		Poco::Thread Worker_;
-		std::atomic_bool Running_ = false;
+		Executor &Executor_;
+		std::mutex DrainMutex_;
+		std::atomic_bool Scheduled_ = false;
+		uint64_t Budget_ = 64;
+		uint64_t Interval_ = 0;
+		uint64_t Retention_ = 0;
+		std::atomic_uint64_t Drains_ = 0;
+		uint64_t DroppedSeen_ = 0;
 		std::vector<uint64_t> SerialNumbers_;
 		std::map<uint64_t, std::shared_ptr<AP>> APs_;
+		//	The rings only answer for points from here on: older ones may belong to APs that
+		//	have since left the board.
+		uint64_t RingsFrom_ = 0;
+		std::mutex PendingMutex_;
+		std::unordered_map<uint64_t, std::shared_ptr<StateReport>> PendingStates_;
+		std::atomic_uint64_t StatesSuperseded_ = 0;
+		BandwidthSeries Bandwidth_;
+		BoardAggregator Aggregates_;
+
+		std::shared_ptr<StateReport> TakePendingState(uint64_t SerialNumber);
+		void RepostPendingStates();
+		void SetTimePointLimits();
+		void Process(VenueMessage &Msg);
+
+		inline void Schedule() {
+			if (!Scheduled_.exchange(true))
+				Executor_.Submit(shared_from_this());
+		}
+
+		inline void Post(VenueMessage &&Msg) {
+			if (Queue_.Push(std::move(Msg)))
+				Schedule();
+		}
 	};
 
 } // namespace OpenWifi
\ No newline at end of file
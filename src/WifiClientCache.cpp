@@ -4,6 +4,7 @@
 
 #include <mutex>
 
+#include "MACAddress.h"
 #include "StorageService.h"
 #include "WifiClientCache.h"
 #include "fmt/format.h"
@@ -33,18 +34,37 @@ namespace OpenWifi {
 			//  Let's replace current cache...
 			std::lock_guard G(Mutex_);
 			Cache_.clear();
-			for (const auto &mac : WifiClients)
-				AddSerialNumber(mac.second, mac.first, G);
+			for (const auto &mac : WifiClients) {
+				MACAddress Station;
+				if (MACAddress::Parse(mac.first, Station))
+					AddSerialNumber(mac.second, Station.Value(), G);
+			}
 		}
 	}
 
+	uint64_t Reverse(uint64_t N) {
+		uint64_t Res = 0;
+
+		for (int i = 0; i < 16; i++) {
+			Res = (Res << 4) + (N & 0x000000000000000f);
+			N >>= 4;
+		}
+		Res >>= 16;
+		return Res;
+	}
+
 	void WifiClientCache::AddSerialNumber(const std::string &venue_id, const std::string &S) {
 		std::lock_guard G(Mutex_);
-		AddSerialNumber(venue_id, S, G);
+		AddSerialNumber(venue_id, std::stoull(S, nullptr, 16), G);
+	}
+
+	void WifiClientCache::AddSerialNumber(const std::string &venue_id, uint64_t SN) {
+		std::lock_guard G(Mutex_);
+		AddSerialNumber(venue_id, SN, G);
 	}
 
 	void
-	WifiClientCache::AddSerialNumber(const std::string &venue_id, const std::string &S,
+	WifiClientCache::AddSerialNumber(const std::string &venue_id, uint64_t SN,
 									 [[maybe_unused]] std::lock_guard<std::recursive_mutex> &G) {
 		auto VenueIt = Cache_.find(venue_id);
 		if (VenueIt == Cache_.end()) {
@@ -52,15 +72,13 @@ namespace OpenWifi {
 			VenueIt = Cache_.find(venue_id);
 		}
 
-		uint64_t SN = std::stoull(S, nullptr, 16);
 		if (std::find(std::begin(VenueIt->second.SNs_), std::end(VenueIt->second.SNs_), SN) ==
 			std::end(VenueIt->second.SNs_)) {
 			auto insert_point =
 				std::lower_bound(VenueIt->second.SNs_.begin(), VenueIt->second.SNs_.end(), SN);
 			VenueIt->second.SNs_.insert(insert_point, SN);
 
-			auto R = ReverseSerialNumber(S);
-			uint64_t RSN = std::stoull(R, nullptr, 16);
+			uint64_t RSN = Reverse(SN);
 			auto rev_insert_point = std::lower_bound(VenueIt->second.Reverse_SNs_.begin(),
 													 VenueIt->second.Reverse_SNs_.end(), RSN);
 			VenueIt->second.Reverse_SNs_.insert(rev_insert_point, RSN);
@@ -89,17 +107,6 @@ namespace OpenWifi {
 		}
 	}
 
-	uint64_t Reverse(uint64_t N) {
-		uint64_t Res = 0;
-
-		for (int i = 0; i < 16; i++) {
-			Res = (Res << 4) + (N & 0x000000000000000f);
-			N >>= 4;
-		}
-		Res >>= 16;
-		return Res;
-	}
-
 	void WifiClientCache::ReturnNumbers(const std::string &S, uint HowMany,
 										const std::vector<uint64_t> &SNArr,
 										std::vector<uint64_t> &A, bool ReverseResult) {
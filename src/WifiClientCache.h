@@ -18,6 +18,7 @@ namespace OpenWifi {
 		int Start() override;
 		void Stop() override;
 		void AddSerialNumber(const std::string &venueId, const std::string &SerialNumber);
+		void AddSerialNumber(const std::string &venueId, uint64_t SerialNumber);
 		void DeleteSerialNumber(const std::string &venueId, const std::string &SerialNumber);
 		void FindNumbers(const std::string &venueId, const std::string &SerialNumber,
 						 std::uint64_t start, std::uint64_t HowMany, std::vector<uint64_t> &A);
@@ -46,7 +47,7 @@ namespace OpenWifi {
 		Poco::Timer Timer_;
 		std::unique_ptr<Poco::TimerCallback<WifiClientCache>> TimerCallback_;
 
-		void AddSerialNumber(const std::string &venueId, const std::string &S,
+		void AddSerialNumber(const std::string &venueId, uint64_t SerialNumber,
 							 std::lock_guard<std::recursive_mutex> &G);
 
 		void ReturnNumbers(const std::string &S, uint HowMany, const std::vector<uint64_t> &SNArr,
@@ -6,7 +6,6 @@
 
 #include "fmt/format.h"
 #include "framework/MicroServiceFuncs.h"
-#include "cppkafka/utils/consumer_dispatcher.h"
 
 namespace OpenWifi {
 
@@ -137,10 +136,10 @@ namespace OpenWifi {
 	}
 
 	inline void KafkaConsumer::run() {
-		Utils::SetThreadName("Kafka:Cons");
+		Utils::SetThreadName(fmt::format("Kafka:Cons:{}", Id_).c_str());
 
-		Poco::Logger &Logger_ =
-			Poco::Logger::create("KAFKA-CONSUMER", KafkaManager()->Logger().getChannel());
+		Poco::Logger &Logger_ = Poco::Logger::create(fmt::format("KAFKA-CONSUMER-{}", Id_),
+													 KafkaManager()->Logger().getChannel());
 
 		poco_information(Logger_, "Starting...");
 
@@ -164,20 +163,31 @@ namespace OpenWifi {
 
 		cppkafka::Consumer Consumer(Config);
 		Consumer.set_assignment_callback([&](cppkafka::TopicPartitionList &partitions) {
+			Partitions_ = partitions.size();
 			if (!partitions.empty()) {
-				poco_information(Logger_, fmt::format("Partition assigned: {}...",
+				poco_information(Logger_, fmt::format("Partition assigned: {} partitions, first {}...",
+													  partitions.size(),
 													  partitions.front().get_partition()));
 			}
 		});
 		Consumer.set_revocation_callback([&](const cppkafka::TopicPartitionList &partitions) {
+			Partitions_ = 0;
 			if (!partitions.empty()) {
-				poco_information(Logger_, fmt::format("Partition revocation: {}...",
+				poco_information(Logger_, fmt::format("Partition revocation: {} partitions, first {}...",
+													  partitions.size(),
 													  partitions.front().get_partition()));
 			}
+			//	whatever was processed on these partitions must be committed before another
+			//	member of the group picks them up.
+			CommitOffsets(Consumer, Logger_, false, &partitions);
 		});
 
-		// bool AutoCommit = MicroServiceConfigGetBool("openwifi.kafka.auto.commit", false);
-		// auto BatchSize = MicroServiceConfigGetInt("openwifi.kafka.consumer.batchsize", 100);
+		AutoCommit_ = MicroServiceConfigGetBool("openwifi.kafka.auto.commit", false);
+		auto BatchSize = MicroServiceConfigGetInt("openwifi.kafka.consumer.batchsize", 100);
+		if (BatchSize < 1)
+			BatchSize = 1;
+		auto CommitInterval = std::chrono::milliseconds(
+			MicroServiceConfigGetInt("openwifi.kafka.consumer.commit.interval", 1000));
 
 		Types::StringVec Topics;
 		std::for_each(Topics_.begin(),Topics_.end(),
@@ -185,44 +195,94 @@ namespace OpenWifi {
 		Consumer.subscribe(Topics);
 
 		Running_ = true;
-		std::vector<cppkafka::Message> MsgVec;
-
-		Dispatcher_ = std::make_unique<cppkafka::ConsumerDispatcher>(Consumer);
-
-		Dispatcher_->run(
-			// Callback executed whenever a new message is consumed
-			[&](cppkafka::Message msg) {
-				// Print the key (if any)
-				std::lock_guard G(ConsumerMutex_);
-				auto It = Notifiers_.find(msg.get_topic());
-				if (It != Notifiers_.end()) {
-					const auto &FL = It->second;
-					for (const auto &[CallbackFunc, _] : FL) {
-						try {
-							CallbackFunc(msg.get_key(), msg.get_payload());
-						} catch(const Poco::Exception &E) {
-
-						} catch(...) {
-
-						}
+		uint64_t Uncommitted = 0;
+		auto LastCommit = std::chrono::steady_clock::now();
+
+		while (Running_) {
+			try {
+				auto Messages = Consumer.poll_batch(BatchSize, std::chrono::milliseconds(100));
+				for (auto &msg : Messages) {
+					if (!msg)
+						continue;
+					if (msg.get_error()) {
+						if (!msg.is_eof())
+							poco_warning(Logger_,
+										 fmt::format("Error: {}", msg.get_error().to_string()));
+						continue;
 					}
+					auto Partition = std::make_pair(msg.get_topic(), msg.get_partition());
+					auto NextOffset = msg.get_offset() + 1;
+					KafkaManager()->Dispatch(
+						std::make_shared<const KafkaIncomingMessage>(std::move(msg)));
+					Consumed_++;
+					//	receivers have queued the message by now, so it is safe to move past it.
+					if (!AutoCommit_) {
+						std::lock_guard G(OffsetMutex_);
+						PendingOffsets_[Partition] = NextOffset;
+					}
+					Uncommitted++;
+				}
+
+				auto Now = std::chrono::steady_clock::now();
+				if (Uncommitted >= (uint64_t)BatchSize ||
+					(Uncommitted && (Now - LastCommit) >= CommitInterval)) {
+					CommitOffsets(Consumer, Logger_, true);
+					Uncommitted = 0;
+					LastCommit = Now;
 				}
-				Consumer.commit(msg);
-			},
-			// Whenever there's an error (other than the EOF soft error)
-			[&Logger_](cppkafka::Error error) {
-				poco_warning(Logger_,fmt::format("Error: {}", error.to_string()));
-			},
-			// Whenever EOF is reached on a partition, print this
-			[&Logger_](cppkafka::ConsumerDispatcher::EndOfFile, const cppkafka::TopicPartition& topic_partition) {
-				poco_debug(Logger_,fmt::format("Partition {} EOF", topic_partition.get_partition()));
+			} catch (const cppkafka::HandleException &E) {
+				poco_warning(Logger_,
+							 fmt::format("Caught a Kafka exception (consumer): {}", E.what()));
+			} catch (const Poco::Exception &E) {
+				Logger_.log(E);
+			} catch (...) {
+				poco_error(Logger_, "std::exception");
 			}
-		);
+		}
 
+		CommitOffsets(Consumer, Logger_, false);
 		Consumer.unsubscribe();
 		poco_information(Logger_, "Stopped...");
 	}
 
+	//	Commits the highest processed offset of every partition seen since the last commit. When
+	//	Only is set, just those partitions are committed (and forgotten).
+	void KafkaConsumer::CommitOffsets(cppkafka::Consumer &Consumer, Poco::Logger &Logger_,
+									  bool Async, const cppkafka::TopicPartitionList *Only) {
+		if (AutoCommit_)
+			return;
+
+		cppkafka::TopicPartitionList Offsets;
+		{
+			std::lock_guard G(OffsetMutex_);
+			if (Only == nullptr) {
+				for (const auto &[Partition, Offset] : PendingOffsets_)
+					Offsets.emplace_back(Partition.first, Partition.second, Offset);
+				PendingOffsets_.clear();
+			} else {
+				for (const auto &TP : *Only) {
+					auto It = PendingOffsets_.find(
+						std::make_pair(TP.get_topic(), TP.get_partition()));
+					if (It == PendingOffsets_.end())
+						continue;
+					Offsets.emplace_back(TP.get_topic(), TP.get_partition(), It->second);
+					PendingOffsets_.erase(It);
+				}
+			}
+		}
+		if (Offsets.empty())
+			return;
+
+		try {
+			if (Async)
+				Consumer.async_commit(Offsets);
+			else
+				Consumer.commit(Offsets);
+		} catch (const cppkafka::HandleException &E) {
+			poco_warning(Logger_, fmt::format("Offset commit failed: {}", E.what()));
+		}
+	}
+
 	void KafkaProducer::Start() {
 		if (!Running_) {
 			Running_ = true;
@@ -253,16 +313,23 @@ namespace OpenWifi {
 	void KafkaConsumer::Stop() {
 		if (Running_) {
 			Running_ = false;
-			if(Dispatcher_) {
-				Dispatcher_->stop();
-			}
 			Worker_.join();
 		}
 	}
 
-	std::uint64_t KafkaConsumer::RegisterTopicWatcher(const std::string &Topic,
-											   Types::TopicNotifyFunction &F) {
-		std::lock_guard G(ConsumerMutex_);
+	void KafkaConsumer::GetStats(Poco::JSON::Object &Obj) const {
+		Poco::JSON::Array TopicArray;
+		for (const auto &Topic : Topics_)
+			TopicArray.add(Topic);
+		Obj.set("id", Id_);
+		Obj.set("topics", TopicArray);
+		Obj.set("partitions", Partitions_.load());
+		Obj.set("consumed", Consumed_.load());
+	}
+
+	std::uint64_t KafkaManager::RegisterTopicWatcher(const std::string &Topic,
+													 Types::TopicNotifyFunction &F) {
+		std::unique_lock G(NotifiersMutex_);
 		auto It = Notifiers_.find(Topic);
 		if (It == Notifiers_.end()) {
 			Types::TopicNotifyFunctionList L;
@@ -271,28 +338,76 @@ namespace OpenWifi {
 		} else {
 			It->second.emplace(It->second.end(), std::make_pair(F, FunctionId_));
 		}
-		Topics_.insert(Topic);
 		return FunctionId_++;
 	}
 
-	void KafkaConsumer::UnregisterTopicWatcher(const std::string &Topic, int Id) {
-		std::lock_guard G(ConsumerMutex_);
+	void KafkaManager::UnregisterTopicWatcher(const std::string &Topic, uint64_t Id) {
+		std::unique_lock G(NotifiersMutex_);
 		auto It = Notifiers_.find(Topic);
 		if (It != Notifiers_.end()) {
 			Types::TopicNotifyFunctionList &L = It->second;
 			for (auto it = L.begin(); it != L.end(); it++)
-				if (it->second == Id) {
+				if (it->second == (int)Id) {
 					L.erase(it);
 					break;
 				}
 		}
 	}
 
+	void KafkaManager::Dispatch(const Types::KafkaIncomingMessagePtr &Msg) {
+		std::shared_lock G(NotifiersMutex_);
+		auto It = Notifiers_.find(Msg->Message().get_topic());
+		if (It != Notifiers_.end()) {
+			const auto &FL = It->second;
+			for (const auto &[CallbackFunc, _] : FL) {
+				try {
+					CallbackFunc(Msg);
+				} catch(const Poco::Exception &E) {
+
+				} catch(...) {
+
+				}
+			}
+		}
+	}
+
+	void KafkaManager::GetConsumerStats(Poco::JSON::Array &Arr) const {
+		for (const auto &Consumer : Consumers_) {
+			Poco::JSON::Object Obj;
+			Consumer->GetStats(Obj);
+			Arr.add(Obj);
+		}
+	}
+
 	int KafkaManager::Start() {
 		if (!KafkaEnabled_)
 			return 0;
 		MaxPayloadSize_ = MicroServiceConfigGetInt("openwifi.kafka.max.payload", 250000);
-		ConsumerThr_.Start();
+
+		//	Watchers register before the manager starts, so the topic list is known here.
+		auto Threads = MicroServiceConfigGetInt("openwifi.kafka.consumer.threads", 1);
+		if (Threads < 1)
+			Threads = 1;
+		auto PerTopic = MicroServiceConfigGetBool("openwifi.kafka.consumer.pertopic", false);
+		std::vector<std::set<std::string>> Subscriptions;
+		{
+			std::shared_lock G(NotifiersMutex_);
+			if (PerTopic) {
+				for (const auto &[Topic, _] : Notifiers_)
+					Subscriptions.push_back(std::set<std::string>{Topic});
+			} else {
+				Subscriptions.emplace_back();
+				for (const auto &[Topic, _] : Notifiers_)
+					Subscriptions.back().insert(Topic);
+			}
+		}
+		for (const auto &Topics : Subscriptions) {
+			for (uint64_t i = 0; i < Threads; ++i) {
+				Consumers_.push_back(std::make_unique<KafkaConsumer>(Consumers_.size(), Topics));
+				Consumers_.back()->Start();
+			}
+		}
+		poco_information(Logger(), fmt::format("Started {} consumer(s).", Consumers_.size()));
 		ProducerThr_.Start();
 		return 0;
 	}
@@ -301,7 +416,9 @@ namespace OpenWifi {
 		if (KafkaEnabled_) {
 			poco_information(Logger(), "Stopping...");
 			ProducerThr_.Stop();
-			ConsumerThr_.Stop();
+			for (auto &Consumer : Consumers_)
+				Consumer->Stop();
+			Consumers_.clear();
 			poco_information(Logger(), "Stopped...");
 			return;
 		}
@@ -328,14 +445,4 @@ namespace OpenWifi {
 						   MicroServiceID(), MicroServicePrivateEndPoint(), PayLoad ) ;
 	}
 
-	void KafkaManager::PartitionAssignment(const cppkafka::TopicPartitionList &partitions) {
-		poco_information(
-			Logger(), fmt::format("Partition assigned: {}...", partitions.front().get_partition()));
-	}
-
-	void KafkaManager::PartitionRevocation(const cppkafka::TopicPartitionList &partitions) {
-		poco_information(Logger(), fmt::format("Partition revocation: {}...",
-											   partitions.front().get_partition()));
-	}
-
 } // namespace OpenWifi
@@ -6,6 +6,7 @@
 
 #include "Poco/Notification.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/JSON/Array.h"
 #include "Poco/JSON/Object.h"
 #include "framework/KafkaTopics.h"
 #include "framework/OpenWifiTypes.h"
@@ -31,6 +32,24 @@ namespace OpenWifi {
 		std::string Payload_;
 	};
 
+	//	A consumed message as handed to topic watchers. It owns the librdkafka buffer, so Key() and
+	//	Payload() stay valid for as long as a watcher holds on to the handle: nothing is copied.
+	class KafkaIncomingMessage {
+	  public:
+		explicit KafkaIncomingMessage(cppkafka::Message &&Msg) : Msg_(std::move(Msg)) {}
+
+		inline std::string_view Key() const { return View(Msg_.get_key()); }
+		inline std::string_view Payload() const { return View(Msg_.get_payload()); }
+		inline const cppkafka::Message &Message() const { return Msg_; }
+
+	  private:
+		cppkafka::Message Msg_;
+
+		static inline std::string_view View(const cppkafka::Buffer &B) {
+			return {reinterpret_cast<const char *>(B.get_data()), B.get_size()};
+		}
+	};
+
 	class KafkaProducer : public Poco::Runnable {
 	  public:
 		void run() override;
@@ -45,24 +64,30 @@ namespace OpenWifi {
 		Poco::NotificationQueue Queue_;
 	};
 
+	//	One group member with its own poll thread. KafkaManager may run several of them, either on
+	//	the same topics (the group splits the partitions between them) or one set per topic.
 	class KafkaConsumer : public Poco::Runnable {
 	  public:
+		KafkaConsumer(uint64_t Id, const std::set<std::string> &Topics) : Id_(Id), Topics_(Topics) {}
+
 		void Start();
 		void Stop();
+		void GetStats(Poco::JSON::Object &Obj) const;
 
 	  private:
-		std::mutex 				ConsumerMutex_;
-		Types::NotifyTable 		Notifiers_;
+		uint64_t 				Id_ = 0;
+		std::set<std::string>	Topics_;
 		Poco::Thread 			Worker_;
 		mutable std::atomic_bool Running_ = false;
-		uint64_t 				FunctionId_ = 1;
-		std::unique_ptr<cppkafka::ConsumerDispatcher> 	Dispatcher_;
-		std::set<std::string>	Topics_;
+		bool 					AutoCommit_ = false;
+		std::mutex 				OffsetMutex_;
+		std::map<std::pair<std::string, int>, int64_t> PendingOffsets_;
+		std::atomic_uint64_t 	Consumed_ = 0;
+		std::atomic_uint64_t 	Partitions_ = 0;
 
 		void run() override;
-		friend class KafkaManager;
-		std::uint64_t RegisterTopicWatcher(const std::string &Topic, Types::TopicNotifyFunction &F);
-		void UnregisterTopicWatcher(const std::string &Topic, int Id);
+		void CommitOffsets(cppkafka::Consumer &Consumer, Poco::Logger &Logger_, bool Async,
+						   const cppkafka::TopicPartitionList *Only = nullptr);
 	};
 
 	class KafkaManager : public SubSystemServer {
@@ -87,12 +112,9 @@ namespace OpenWifi {
 
 		[[nodiscard]] std::string WrapSystemId(const std::string & PayLoad);
 		[[nodiscard]] inline bool Enabled() const { return KafkaEnabled_; }
-		inline std::uint64_t RegisterTopicWatcher(const std::string &Topic, Types::TopicNotifyFunction &F) {
-			return ConsumerThr_.RegisterTopicWatcher(Topic,F);
-		}
-		inline void UnregisterTopicWatcher(const std::string &Topic, uint64_t Id) {
-			return ConsumerThr_.UnregisterTopicWatcher(Topic,Id);
-		}
+		std::uint64_t RegisterTopicWatcher(const std::string &Topic, Types::TopicNotifyFunction &F);
+		void UnregisterTopicWatcher(const std::string &Topic, uint64_t Id);
+		void GetConsumerStats(Poco::JSON::Array &Arr) const;
 
 		std::uint64_t KafkaManagerMaximumPayloadSize() const { return MaxPayloadSize_; }
 
@@ -100,11 +122,15 @@ namespace OpenWifi {
 		bool KafkaEnabled_ = false;
 		std::string SystemInfoWrapper_;
 		KafkaProducer ProducerThr_;
-		KafkaConsumer ConsumerThr_;
+		std::vector<std::unique_ptr<KafkaConsumer>> Consumers_;
 		std::uint64_t MaxPayloadSize_ = 250000;
 
-		void PartitionAssignment(const cppkafka::TopicPartitionList &partitions);
-		void PartitionRevocation(const cppkafka::TopicPartitionList &partitions);
+		//	Shared by all consumers: dispatching only takes the lock shared.
+		mutable std::shared_mutex NotifiersMutex_;
+		Types::NotifyTable Notifiers_;
+		uint64_t FunctionId_ = 1;
+
+		void Dispatch(const Types::KafkaIncomingMessagePtr &Msg);
 
 		KafkaManager() noexcept : SubSystemServer("KafkaManager", "KAFKA-SVR", "openwifi.kafka") {}
 	};
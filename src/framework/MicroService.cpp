@@ -475,8 +475,8 @@ namespace OpenWifi {
         ServerApplication::initialize(self);
         DaemonPostInitialization(self);
 
-        Types::TopicNotifyFunction F = [this](const std::string &Key, const std::string &Payload) {
-            this->BusMessageReceived(Key, Payload);
+        Types::TopicNotifyFunction F = [this](const Types::KafkaIncomingMessagePtr &Msg) {
+            this->BusMessageReceived(std::string(Msg->Key()), std::string(Msg->Payload()));
         };
         KafkaManager()->RegisterTopicWatcher(KafkaTopics::SERVICE_EVENTS, F);
     }
@@ -485,8 +485,8 @@ namespace OpenWifi {
         LoadConfigurationFile();
         InitializeLoggingSystem();
 
-        Types::TopicNotifyFunction F = [this](const std::string &Key, const std::string &Payload) {
-            this->BusMessageReceived(Key, Payload);
+        Types::TopicNotifyFunction F = [this](const Types::KafkaIncomingMessagePtr &Msg) {
+            this->BusMessageReceived(std::string(Msg->Key()), std::string(Msg->Payload()));
         };
         KafkaManager()->RegisterTopicWatcher(KafkaTopics::SERVICE_EVENTS, F);
     }
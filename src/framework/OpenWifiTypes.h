@@ -7,12 +7,17 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace OpenWifi {
+	class KafkaIncomingMessage;
+}
+
 namespace OpenWifi::Types {
 	typedef std::pair<std::string, std::string> StringPair;
 	typedef std::vector<StringPair> StringPairVec;
@@ -20,7 +25,8 @@ namespace OpenWifi::Types {
 	typedef std::vector<std::string> StringVec;
 	typedef std::set<std::string> StringSet;
 	typedef std::map<std::string, std::set<std::string>> StringMapStringSet;
-	typedef std::function<void(const std::string &, const std::string &)> TopicNotifyFunction;
+	typedef std::shared_ptr<const KafkaIncomingMessage> KafkaIncomingMessagePtr;
+	typedef std::function<void(const KafkaIncomingMessagePtr &)> TopicNotifyFunction;
 	typedef std::list<std::pair<TopicNotifyFunction, int>> TopicNotifyFunctionList;
 	typedef std::map<std::string, TopicNotifyFunctionList> NotifyTable;
 	typedef std::map<std::string, uint64_t> CountedMap;
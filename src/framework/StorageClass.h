@@ -61,6 +61,7 @@ namespace OpenWifi {
 		Poco::Data::PostgreSQL::Connector PostgresConn_;
 		Poco::Data::MySQL::Connector MySQLConn_;
 		DBType dbType_ = sqlite;
+		std::string ConnectionString_;
 	};
 
 #ifdef SMALL_BUILD
@@ -132,6 +133,7 @@ namespace OpenWifi {
 									" connect_timeout=" + ConnectionTimeout;
 
 		Poco::Data::PostgreSQL::Connector::registerConnector();
+		ConnectionString_ = ConnectionStr;
 		Pool_ = std::make_shared<Poco::Data::SessionPool>(PostgresConn_.name(), ConnectionStr, 8,
 														  NumSessions, IdleTime);
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <iostream>
@@ -286,6 +287,7 @@ namespace ORM {
 			}
 		}
 
+		[[nodiscard]] const std::string &TableName() const { return TableName_; };
 		[[nodiscard]] const std::string &CreateFields() const { return CreateFields_; };
 		[[nodiscard]] const std::string &SelectFields() const { return SelectFields_; };
 		[[nodiscard]] const std::string &SelectList() const { return SelectList_; };
@@ -439,6 +441,55 @@ namespace ORM {
 			return false;
 		}
 
+		//	Rows per multi-row INSERT in CreateRecords.
+		inline void SetBatchRows(uint64_t Rows) { BatchRows_ = Rows ? Rows : 1; }
+
+		//	Inserts all the records in one transaction, using multi-row INSERT statements of at
+		//	most BatchRows_ rows, fewer when that would exceed the bound parameters the database
+		//	accepts in one statement.
+		bool CreateRecords(const std::vector<RecordType> &Records) {
+			if (Records.empty())
+				return true;
+			try {
+				std::vector<RecordTuple> Rows(Records.size());
+				for (std::size_t i = 0; i < Records.size(); ++i)
+					Convert(Records[i], Rows[i]);
+
+				auto PerStatement = std::max<std::size_t>(
+					1, std::min<std::size_t>(BatchRows_, MaxParameters() / FieldNames_.size()));
+				Poco::Data::Session Session = Pool_.get();
+				Session.begin();
+				try {
+					for (std::size_t First = 0; First < Rows.size(); First += PerStatement) {
+						auto Count = std::min(PerStatement, Rows.size() - First);
+						Poco::Data::Statement Insert(Session);
+						std::string St = "insert into  " + TableName_ + " ( " + SelectFields_ +
+										 " ) values " + SelectList_;
+						for (std::size_t i = 1; i < Count; ++i)
+							St += ", " + SelectList_;
+						Insert << ConvertParams(St);
+						for (auto i = First; i < First + Count; ++i)
+							Insert.addBind(Poco::Data::Keywords::use(Rows[i]));
+						Insert.execute();
+					}
+					Session.commit();
+				} catch (...) {
+					Session.rollback();
+					throw;
+				}
+
+				if (Cache_) {
+					for (const auto &R : Records)
+						Cache_->Create(R);
+				}
+				return true;
+
+			} catch (const Poco::Exception &E) {
+				Logger_.log(E);
+			}
+			return false;
+		}
+
 		template <typename T>
 		bool GetRecord(field_name_t FieldName, const T &Value, RecordType &R) {
 			try {
@@ -992,6 +1043,11 @@ namespace ORM {
 			return ValidFieldName(Field);
 		}
 
+		//	SQLite builds before 3.32 accept 999 parameters, PostgreSQL and MySQL 65535.
+		[[nodiscard]] inline std::size_t MaxParameters() const {
+			return Type_ == OpenWifi::DBType::sqlite ? 999 : 65535;
+		}
+
 		[[nodiscard]] inline std::string ComputeRange(uint64_t From, uint64_t HowMany) {
 			if (From < 1)
 				From = 0;
@@ -1038,5 +1094,6 @@ namespace ORM {
 		std::string UpdateFields_;
 		std::vector<std::string> IndexCreation_;
 		std::map<std::string, int> FieldNames_;
+		uint64_t BatchRows_ = 500;
 	};
 } // namespace ORM
@@ -0,0 +1,120 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "PostgresCopy.h"
+#include "fmt/format.h"
+#include <algorithm>
+
+#ifndef SMALL_BUILD
+#include "libpq-fe.h"
+#endif
+
+namespace OpenWifi {
+
+	//	Text format: tab separated columns, one row per line, backslash escapes.
+	void PostgresCopy::Append(const std::string &S, std::string &Data) {
+		for (auto c : S) {
+			switch (c) {
+			case '\\':
+				Data += "\\\\";
+				break;
+			case '\t':
+				Data += "\\t";
+				break;
+			case '\n':
+				Data += "\\n";
+				break;
+			case '\r':
+				Data += "\\r";
+				break;
+			default:
+				Data += c;
+			}
+		}
+	}
+
+	//	bytea in hex format: \x then two digits per byte, the backslash escaped for COPY.
+	void PostgresCopy::Append(const Poco::Data::BLOB &B, std::string &Data) {
+		static const char Hex[] = "0123456789abcdef";
+		Data += "\\\\x";
+		for (auto i = B.begin(); i != B.end(); ++i) {
+			Data += Hex[*i >> 4];
+			Data += Hex[*i & 0xf];
+		}
+	}
+
+#ifndef SMALL_BUILD
+	PostgresCopy::~PostgresCopy() {
+		for (auto Conn : Idle_)
+			PQfinish(Conn);
+	}
+
+	PGconn *PostgresCopy::Acquire() {
+		{
+			std::lock_guard G(Mutex_);
+			if (!Idle_.empty()) {
+				auto Conn = Idle_.back();
+				Idle_.pop_back();
+				return Conn;
+			}
+		}
+		auto Conn = PQconnectdb(ConnectionString_.c_str());
+		if (PQstatus(Conn) != CONNECTION_OK) {
+			poco_warning(Logger_, fmt::format("COPY connection failed: {}", PQerrorMessage(Conn)));
+			PQfinish(Conn);
+			return nullptr;
+		}
+		return Conn;
+	}
+
+	void PostgresCopy::Release(PGconn *Conn) {
+		if (PQstatus(Conn) != CONNECTION_OK) {
+			PQfinish(Conn);
+			return;
+		}
+		std::lock_guard G(Mutex_);
+		Idle_.push_back(Conn);
+	}
+
+	bool PostgresCopy::Send(const std::string &Command, const std::string &Data) {
+		auto Conn = Acquire();
+		if (!Conn)
+			return false;
+
+		auto Result = PQexec(Conn, Command.c_str());
+		bool Started = PQresultStatus(Result) == PGRES_COPY_IN;
+		PQclear(Result);
+		if (!Started) {
+			poco_warning(Logger_, fmt::format("{}: {}", Command, PQerrorMessage(Conn)));
+			Release(Conn);
+			return false;
+		}
+
+		constexpr std::size_t Chunk = 256 * 1024;
+		bool Sent = true;
+		for (std::size_t Offset = 0; Sent && Offset < Data.size(); Offset += Chunk)
+			Sent = PQputCopyData(Conn, Data.data() + Offset,
+								 (int)std::min(Chunk, Data.size() - Offset)) == 1;
+		//	Ending with an error message makes the server discard the rows already sent.
+		Sent = PQputCopyEnd(Conn, Sent ? nullptr : "client aborted") == 1 && Sent;
+
+		bool Done = Sent;
+		while ((Result = PQgetResult(Conn)) != nullptr) {
+			if (PQresultStatus(Result) != PGRES_COMMAND_OK) {
+				poco_warning(Logger_, fmt::format("{}: {}", Command, PQresultErrorMessage(Result)));
+				Done = false;
+			}
+			PQclear(Result);
+		}
+		Release(Conn);
+		return Done;
+	}
+#else
+	PostgresCopy::~PostgresCopy() = default;
+	PGconn *PostgresCopy::Acquire() { return nullptr; }
+	void PostgresCopy::Release(PGconn *) {}
+	bool PostgresCopy::Send(const std::string &, const std::string &) { return false; }
+#endif
+
+} // namespace OpenWifi
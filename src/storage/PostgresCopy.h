@@ -0,0 +1,66 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/Data/LOB.h"
+#include "Poco/Logger.h"
+#include "Poco/Tuple.h"
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+typedef struct pg_conn PGconn;
+
+namespace OpenWifi {
+
+	//	Bulk ingest for PostgreSQL: rows are streamed through COPY ... FROM STDIN in text format
+	//	on connections of its own, since the session pool does not expose libpq.
+	class PostgresCopy {
+	  public:
+		PostgresCopy(const std::string &ConnectionString, Poco::Logger &L)
+			: ConnectionString_(ConnectionString), Logger_(L) {}
+		~PostgresCopy();
+
+		//	Copies all the rows in one COPY statement: either all of them are stored or none.
+		template <typename RecordTuple>
+		bool Copy(const std::string &Table, const std::string &Fields,
+				  const std::vector<RecordTuple> &Rows) {
+			std::string Data;
+			for (const auto &Row : Rows) {
+				AppendRow(Row, Data,
+						  std::make_index_sequence<(std::size_t)RecordTuple::length>{});
+				Data += '\n';
+			}
+			return Send("COPY " + Table + " ( " + Fields + " ) FROM STDIN", Data);
+		}
+
+	  private:
+		std::string ConnectionString_;
+		Poco::Logger &Logger_;
+		std::mutex Mutex_;
+		std::vector<PGconn *> Idle_;
+
+		bool Send(const std::string &Command, const std::string &Data);
+		PGconn *Acquire();
+		void Release(PGconn *Conn);
+
+		static void Append(const std::string &S, std::string &Data);
+		static void Append(const Poco::Data::BLOB &B, std::string &Data);
+		static inline void Append(bool B, std::string &Data) { Data += B ? 't' : 'f'; }
+		template <typename T> static inline void Append(T V, std::string &Data) {
+			static_assert(std::is_arithmetic_v<T>);
+			Data += std::to_string(V);
+		}
+
+		template <typename RecordTuple, std::size_t... I>
+		static void AppendRow(const RecordTuple &Row, std::string &Data,
+							  std::index_sequence<I...>) {
+			((Data += (I ? "\t" : ""), Append(Row.template get<I>(), Data)), ...);
+		}
+	};
+
+} // namespace OpenWifi
@@ -0,0 +1,169 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "BoundedQueue.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/Logger.h"
+#include "Poco/Thread.h"
+#include "fmt/format.h"
+#include "framework/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace OpenWifi {
+
+	//	Group commit for one table. Producers only queue records; writer threads take what is
+	//	queued, once a batch is full or the window since its first record has passed, and write
+	//	it in one go. A batch that fails is retried, with a growing delay, until it goes through:
+	//	meanwhile records pile up in the queue, and are only lost once it overflows.
+	template <typename Record> class StorageWriter : public Poco::Runnable {
+	  public:
+		typedef std::function<bool(const std::vector<Record> &)> WriteFunction;
+
+		struct Config {
+			uint64_t threads = 1;
+			uint64_t queue_size = 100000;
+			OverloadPolicy policy = OverloadPolicy::drop_oldest;
+			uint64_t batch = 500;
+			uint64_t window_ms = 1000;
+			uint64_t backoff_ms = 100;
+			uint64_t max_backoff_ms = 30000;
+		};
+
+		StorageWriter(const std::string &Name, WriteFunction Write, Poco::Logger &L)
+			: Name_(Name), Write_(std::move(Write)), Logger_(L) {}
+
+		void Start(const Config &C) {
+			C_ = C;
+			C_.threads = std::max<uint64_t>(C_.threads, 1);
+			C_.batch = std::max<uint64_t>(C_.batch, 1);
+			C_.backoff_ms = std::max<uint64_t>(C_.backoff_ms, 1);
+			C_.max_backoff_ms = std::max(C_.max_backoff_ms, C_.backoff_ms);
+			Stopping_ = false;
+			Queue_.Configure(C_.queue_size, C_.policy);
+			for (uint64_t i = 0; i < C_.threads; ++i) {
+				Writers_.push_back(std::make_unique<Poco::Thread>());
+				Writers_.back()->start(*this);
+			}
+		}
+
+		//	Writes what is still queued: a batch that fails from now on is retried once only, after
+		//	the first backoff delay.
+		void Stop() {
+			{
+				std::lock_guard G(WakeMutex_);
+				Stopping_ = true;
+			}
+			Wake_.notify_all();
+			Queue_.Shutdown();
+			for (auto &Writer : Writers_)
+				Writer->join();
+			Writers_.clear();
+			if (DroppedAtStop_)
+				poco_error(Logger_, fmt::format("{}: {} records could not be written at shutdown.",
+												Name_, DroppedAtStop_.load()));
+		}
+
+		//	Key is only used by the coalesce policy.
+		inline void Write(uint64_t Key, Record &&R) { Queue_.Push(Key, std::move(R)); }
+
+		void run() override {
+			Utils::SetThreadName(fmt::format("wr-{}", Name_).c_str());
+			std::vector<Record> Batch;
+			Batch.reserve(C_.batch);
+			while (Queue_.PopBatch(Batch, C_.batch, std::chrono::milliseconds(C_.window_ms))) {
+				auto Backoff = C_.backoff_ms;
+				bool LastTry = false;
+				while (!Flush(Batch)) {
+					std::unique_lock G(WakeMutex_);
+					if (LastTry) {
+						poco_error(Logger_, fmt::format("{}: dropping {} records at shutdown.",
+														Name_, Batch.size()));
+						Failed_ += Batch.size();
+						DroppedAtStop_ += Batch.size();
+						break;
+					}
+					Retries_++;
+					if (Stopping_) {
+						//	No more waiting for the database: one last try.
+						LastTry = true;
+						Backoff = C_.backoff_ms;
+					}
+					poco_warning(Logger_,
+								 fmt::format("{}: writing {} records failed, retry in {} ms.",
+											 Name_, Batch.size(), Backoff));
+					if (LastTry)
+						Wake_.wait_for(G, std::chrono::milliseconds(Backoff));
+					else
+						Wake_.wait_for(G, std::chrono::milliseconds(Backoff),
+									   [this] { return Stopping_; });
+					Backoff = std::min(Backoff * 2, C_.max_backoff_ms);
+				}
+				Batch.clear();
+			}
+		}
+
+		void GetStats(Poco::JSON::Object &Obj) {
+			Queue_.GetStats(Obj);
+			uint64_t Batches = Batches_;
+			Obj.set("writers", Writers_.size());
+			Obj.set("written", Written_.load());
+			Obj.set("failed", Failed_.load());
+			Obj.set("retries", Retries_.load());
+			Obj.set("batches", Batches);
+			Obj.set("avgBatch", Batches ? Written_ / Batches : 0);
+			Obj.set("maxBatch", MaxBatch_.load());
+			Obj.set("avgFlushNs", Batches ? FlushNs_ / Batches : 0);
+			Obj.set("maxFlushNs", MaxFlushNs_.load());
+		}
+
+	  private:
+		std::string Name_;
+		WriteFunction Write_;
+		Poco::Logger &Logger_;
+		Config C_;
+		BoundedQueue<Record> Queue_;
+		std::vector<std::unique_ptr<Poco::Thread>> Writers_;
+		std::mutex WakeMutex_;
+		std::condition_variable Wake_;
+		bool Stopping_ = false;
+		std::atomic_uint64_t Written_ = 0;
+		std::atomic_uint64_t Failed_ = 0;
+		std::atomic_uint64_t DroppedAtStop_ = 0;
+		std::atomic_uint64_t Retries_ = 0;
+		std::atomic_uint64_t Batches_ = 0;
+		std::atomic_uint64_t MaxBatch_ = 0;
+		std::atomic_uint64_t FlushNs_ = 0;
+		std::atomic_uint64_t MaxFlushNs_ = 0;
+
+		static inline void RaiseTo(std::atomic_uint64_t &Max, uint64_t Value) {
+			auto Current = Max.load();
+			while (Value > Current && !Max.compare_exchange_weak(Current, Value))
+				;
+		}
+
+		bool Flush(const std::vector<Record> &Batch) {
+			auto Start = std::chrono::steady_clock::now();
+			if (!Write_(Batch))
+				return false;
+			uint64_t Ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+							  std::chrono::steady_clock::now() - Start)
+							  .count();
+			Written_ += Batch.size();
+			Batches_++;
+			FlushNs_ += Ns;
+			RaiseTo(MaxBatch_, Batch.size());
+			RaiseTo(MaxFlushNs_, Ns);
+			return true;
+		}
+	};
+
+} // namespace OpenWifi
@@ -0,0 +1,416 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "TimePointCodec.h"
+#include "Poco/JSON/Stringifier.h"
+#include "framework/RESTAPI_utils.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <zlib.h>
+
+namespace OpenWifi::TimePointCodec {
+
+	using namespace AnalyticsObjects;
+
+	//	The fields of each structure, in blob order. Encoding and decoding share these lists, so
+	//	they can not disagree. Appending a field, or changing one, needs a new Version, and the
+	//	field only read from blobs of that version on.
+	template <typename A> void Fields(A &a, UE_rate &p) {
+		a(p.bitrate, p.mcs, p.nss, p.ht, p.sgi, p.chwidth);
+	}
+
+	template <typename A> void Fields(A &a, AveragePoint &p) { a(p.min, p.max, p.avg); }
+
+	template <typename A> void Fields(A &a, Fingerprint &p) { a(p.json); }
+
+	template <typename A> void Fields(A &a, TIDstat_entry &p) {
+		a(p.rx_msdu, p.tx_msdu, p.tx_msdu_failed, p.tx_msdu_retries);
+	}
+
+	template <typename A> void Fields(A &a, UETimePoint &p) {
+		a(p.station, p.rssi, p.tx_bytes, p.rx_bytes, p.tx_duration, p.rx_packets, p.tx_packets,
+		  p.tx_retries, p.tx_failed, p.connected, p.inactive, p.tx_bytes_bw, p.rx_bytes_bw,
+		  p.tx_packets_bw, p.rx_packets_bw, p.tx_failed_pct, p.tx_retries_pct, p.tx_duration_pct,
+		  p.tx_bytes_delta, p.rx_bytes_delta, p.tx_duration_delta, p.rx_packets_delta,
+		  p.tx_packets_delta, p.tx_retries_delta, p.tx_failed_delta, p.tx_rate, p.rx_rate,
+		  p.fingerprint);
+		if (a.Version() >= 2)
+			a(p.tidstats);
+	}
+
+	template <typename A> void Fields(A &a, SSIDTimePoint &p) {
+		a(p.bssid, p.mode, p.ssid, p.band, p.channel, p.associations, p.tx_bytes_bw,
+		  p.rx_bytes_bw, p.tx_packets_bw, p.rx_packets_bw, p.tx_failed_pct, p.tx_retries_pct,
+		  p.tx_duration_pct);
+	}
+
+	template <typename A> void Fields(A &a, APTimePoint &p) {
+		a(p.collisions, p.multicast, p.rx_bytes, p.rx_dropped, p.rx_errors, p.rx_packets,
+		  p.tx_bytes, p.tx_dropped, p.tx_errors, p.tx_packets, p.tx_bytes_bw, p.rx_bytes_bw,
+		  p.rx_dropped_pct, p.tx_dropped_pct, p.rx_packets_bw, p.tx_packets_bw, p.rx_errors_pct,
+		  p.tx_errors_pct, p.tx_bytes_delta, p.rx_bytes_delta, p.rx_dropped_delta,
+		  p.tx_dropped_delta, p.rx_packets_delta, p.tx_packets_delta, p.rx_errors_delta,
+		  p.tx_errors_delta);
+	}
+
+	template <typename A> void Fields(A &a, RadioTimePoint &p) {
+		a(p.band, p.channel_width, p.active_ms, p.busy_ms, p.receive_ms, p.transmit_ms,
+		  p.tx_power, p.channel, p.temperature, p.noise, p.active_pct, p.busy_pct, p.receive_pct,
+		  p.transmit_pct);
+	}
+
+	template <typename A> void Fields(A &a, DeviceInfo &p) {
+		a(p.boardId, p.type, p.serialNumber, p.deviceType, p.lastContact, p.lastPing,
+		  p.lastState, p.lastFirmware, p.lastFirmwareUpdate, p.lastConnection,
+		  p.lastDisconnection, p.pings, p.states, p.connected, p.connectionIp, p.associations_2g,
+		  p.associations_5g, p.associations_6g, p.health, p.lastHealth, p.locale, p.uptime,
+		  p.memory);
+	}
+
+	template <typename A> void Fields(A &a, DeviceTimePoint &p) {
+		a(p.ap_data, p.ssid_data, p.radio_data, p.device_info);
+	}
+
+	class Writer {
+	  public:
+		explicit Writer(std::string &Out) : Out_(Out) {}
+
+		template <typename... T> inline void operator()(const T &...F) { (Put(F), ...); }
+
+		inline void Put(uint64_t V) {
+			while (V >= 0x80) {
+				Out_ += (char)(V | 0x80);
+				V >>= 7;
+			}
+			Out_ += (char)V;
+		}
+		inline void Put(int64_t V) { Put(((uint64_t)V << 1) ^ (uint64_t)(V >> 63)); }
+		inline void Put(bool V) { Out_ += (char)V; }
+		inline void Put(double V) {
+			uint64_t Bits;
+			std::memcpy(&Bits, &V, sizeof(Bits));
+			Put(__builtin_bswap64(Bits));
+		}
+		inline void Put(const std::string &S) {
+			Put((uint64_t)S.size());
+			Out_ += S;
+		}
+		inline void Put(const MACAddress &M) { Put(M.Value()); }
+		inline void Put(const SSIDName &S) { Put(S.str()); }
+		template <typename T> inline void Put(const std::vector<T> &V) {
+			Put((uint64_t)V.size());
+			for (const auto &E : V)
+				Put(E);
+		}
+		template <typename T> inline void Put(const T &S) { Fields(*this, const_cast<T &>(S)); }
+
+		[[nodiscard]] static inline uint8_t Version() { return TimePointCodec::Version; }
+
+	  private:
+		std::string &Out_;
+	};
+
+	class Reader {
+	  public:
+		Reader(uint8_t BlobVersion, const unsigned char *Data, std::size_t Size)
+			: Version_(BlobVersion), P_(Data), End_(Data + Size) {}
+
+		template <typename... T> inline void operator()(T &...F) { (Get(F), ...); }
+
+		inline void Get(uint64_t &V) {
+			V = 0;
+			for (int Shift = 0; Shift < 64; Shift += 7) {
+				if (P_ == End_)
+					break;
+				auto Byte = *P_++;
+				V |= (uint64_t)(Byte & 0x7f) << Shift;
+				if (!(Byte & 0x80))
+					return;
+			}
+			V = 0;
+			Ok_ = false;
+		}
+		inline void Get(int64_t &V) {
+			uint64_t Z;
+			Get(Z);
+			V = (int64_t)(Z >> 1) ^ -(int64_t)(Z & 1);
+		}
+		inline void Get(bool &V) {
+			if (P_ == End_) {
+				Ok_ = false;
+				return;
+			}
+			V = *P_++ != 0;
+		}
+		inline void Get(double &V) {
+			uint64_t Bits;
+			Get(Bits);
+			Bits = __builtin_bswap64(Bits);
+			std::memcpy(&V, &Bits, sizeof(V));
+		}
+		inline void Get(std::string &S) {
+			auto Size = Count();
+			S.assign((const char *)P_, Size);
+			P_ += Size;
+		}
+		inline void Get(MACAddress &M) {
+			uint64_t V;
+			Get(V);
+			M = MACAddress(V);
+		}
+		inline void Get(SSIDName &S) {
+			std::string Name;
+			Get(Name);
+			S = SSIDName(Name);
+		}
+		template <typename T> inline void Get(std::vector<T> &V) {
+			V.resize(Count());
+			for (auto &E : V)
+				Get(E);
+		}
+		template <typename T> inline void Get(T &S) { Fields(*this, S); }
+
+		//	Complete only if every byte was used.
+		[[nodiscard]] inline bool Done() const { return Ok_ && P_ == End_; }
+		[[nodiscard]] inline uint8_t Version() const { return Version_; }
+
+	  private:
+		uint8_t Version_;
+		const unsigned char *P_;
+		const unsigned char *End_;
+		bool Ok_ = true;
+
+		//	A length: every string byte or array element takes at least one byte of the blob.
+		inline std::size_t Count() {
+			uint64_t N;
+			Get(N);
+			if (N > (uint64_t)(End_ - P_)) {
+				Ok_ = false;
+				return 0;
+			}
+			return N;
+		}
+	};
+
+	enum Compression : uint8_t { none = 0, zlib = 1 };
+
+	//	The largest decompressed blob accepted: well above what any AP reports.
+	static constexpr uint64_t MaxFieldsSize = 64 * 1024 * 1024;
+
+	static std::atomic<Encoding> Current_{Encoding::zlib};
+
+	Encoding EncodingFromString(const std::string &E) {
+		if (E == "json")
+			return Encoding::json;
+		if (E == "binary")
+			return Encoding::binary;
+		return Encoding::zlib;
+	}
+
+	const char *EncodingToString(Encoding E) {
+		switch (E) {
+		case Encoding::json:
+			return "json";
+		case Encoding::binary:
+			return "binary";
+		default:
+			return "zlib";
+		}
+	}
+
+	void SetEncoding(Encoding E) { Current_ = E; }
+	Encoding GetEncoding() { return Current_; }
+
+	void Encode(const DeviceTimePoint &P, Encoding E, std::string &Blob) {
+		thread_local std::string Raw;
+		Raw.clear();
+		Writer Body(Raw);
+		Body(P);
+
+		Blob.clear();
+		Blob += (char)Version;
+		auto CompressionAt = Blob.size();
+		Blob += (char)none;
+		Writer Header(Blob);
+		Header.Put((uint64_t)Raw.size());
+		auto HeaderSize = Blob.size();
+		if (E == Encoding::zlib) {
+			auto Bound = compressBound(Raw.size());
+			Blob.resize(HeaderSize + Bound);
+			uLongf Size = Bound;
+			if (compress2((Bytef *)&Blob[HeaderSize], &Size, (const Bytef *)Raw.data(),
+						  Raw.size(), Z_BEST_SPEED) == Z_OK &&
+				Size < Raw.size()) {
+				Blob.resize(HeaderSize + Size);
+				Blob[CompressionAt] = (char)zlib;
+				return;
+			}
+			Blob.resize(HeaderSize);
+		}
+		Blob += Raw;
+	}
+
+	bool Decode(const unsigned char *Blob, std::size_t Size, DeviceTimePoint &P) {
+		if (Size < 3 || Blob[0] < 1 || Blob[0] > Version)
+			return false;
+		auto BlobVersion = Blob[0];
+		auto Method = Blob[1];
+		uint64_t FieldsSize = 0;
+		auto Header = Blob + 2;
+		for (int Shift = 0; Header < Blob + Size && Shift < 64; Shift += 7) {
+			auto Byte = *Header++;
+			FieldsSize |= (uint64_t)(Byte & 0x7f) << Shift;
+			if (!(Byte & 0x80))
+				break;
+		}
+		auto Body = Header;
+		std::size_t BodySize = Size - (Body - Blob);
+
+		if (Method == none) {
+			if (BodySize != FieldsSize)
+				return false;
+			Reader R(BlobVersion, Body, BodySize);
+			R(P);
+			return R.Done();
+		}
+		if (Method != zlib || FieldsSize > MaxFieldsSize)
+			return false;
+		thread_local std::string Raw;
+		Raw.resize(FieldsSize);
+		uLongf RawSize = FieldsSize;
+		if (uncompress((Bytef *)Raw.data(), &RawSize, Body, BodySize) != Z_OK ||
+			RawSize != FieldsSize)
+			return false;
+		Reader R(BlobVersion, (const unsigned char *)Raw.data(), Raw.size());
+		R(P);
+		return R.Done();
+	}
+
+	bool RoundTrip(const DeviceTimePoint &P, Encoding E) {
+		std::string Blob;
+		Encode(P, E, Blob);
+		DeviceTimePoint Decoded;
+		Decoded.id = P.id;
+		Decoded.boardId = P.boardId;
+		Decoded.timestamp = P.timestamp;
+		Decoded.serialNumber = P.serialNumber;
+		if (!Decode((const unsigned char *)Blob.data(), Blob.size(), Decoded))
+			return false;
+
+		auto Json = [](const DeviceTimePoint &T) {
+			Poco::JSON::Object Obj;
+			T.to_json(Obj);
+			std::ostringstream OS;
+			Poco::JSON::Stringifier::condense(Obj, OS);
+			return OS.str();
+		};
+		if (Json(P) != Json(Decoded))
+			return false;
+		//	tidstats are not part of the JSON.
+		for (std::size_t s = 0; s < P.ssid_data.size(); ++s) {
+			const auto &A = P.ssid_data[s].associations;
+			const auto &B = Decoded.ssid_data[s].associations;
+			for (std::size_t u = 0; u < A.size(); ++u) {
+				if (A[u].tidstats.size() != B[u].tidstats.size())
+					return false;
+				for (std::size_t t = 0; t < A[u].tidstats.size(); ++t) {
+					const auto &X = A[u].tidstats[t], &Y = B[u].tidstats[t];
+					if (X.rx_msdu != Y.rx_msdu || X.tx_msdu != Y.tx_msdu ||
+						X.tx_msdu_failed != Y.tx_msdu_failed ||
+						X.tx_msdu_retries != Y.tx_msdu_retries)
+						return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	struct Counter {
+		std::atomic_uint64_t Points = 0, Bytes = 0, Ns = 0;
+	};
+	static std::array<Counter, operations> Counters_;
+	static std::atomic_uint64_t Failures_ = 0;
+
+	void Count(Operation Op, uint64_t Bytes, std::chrono::steady_clock::time_point Start) {
+		auto &C = Counters_[Op];
+		C.Points++;
+		C.Bytes += Bytes;
+		C.Ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - Start)
+					.count();
+	}
+
+	void CountFailure() { Failures_++; }
+
+	void GetStats(Poco::JSON::Object &Obj) {
+		static const char *Names[] = {"jsonEncode", "jsonDecode", "binaryEncode", "binaryDecode"};
+		Obj.set("encoding", EncodingToString(Current_));
+		for (int Op = 0; Op < operations; ++Op) {
+			const auto &C = Counters_[Op];
+			uint64_t Points = C.Points;
+			Poco::JSON::Object O;
+			O.set("points", Points);
+			O.set("bytes", C.Bytes.load());
+			O.set("ns", C.Ns.load());
+			O.set("avgBytes", Points ? C.Bytes / Points : 0);
+			O.set("avgNs", Points ? C.Ns / Points : 0);
+			Obj.set(Names[Op], O);
+		}
+		Obj.set("decodeFailures", Failures_.load());
+	}
+
+	void Benchmark(const std::vector<DeviceTimePoint> &Points,
+				   std::vector<BenchmarkResult> &Results) {
+		auto Since = [](std::chrono::steady_clock::time_point Start) -> uint64_t {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					   std::chrono::steady_clock::now() - Start)
+				.count();
+		};
+
+		BenchmarkResult Json{EncodingToString(Encoding::json), Points.size()};
+		std::vector<std::array<std::string, 4>> Columns(Points.size());
+		auto Start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < Points.size(); ++i) {
+			Columns[i][0] = RESTAPI_utils::to_string(Points[i].ap_data);
+			Columns[i][1] = RESTAPI_utils::to_string(Points[i].ssid_data);
+			Columns[i][2] = RESTAPI_utils::to_string(Points[i].radio_data);
+			Columns[i][3] = RESTAPI_utils::to_string(Points[i].device_info);
+		}
+		Json.encodeNs = Since(Start);
+		Start = std::chrono::steady_clock::now();
+		for (const auto &C : Columns) {
+			DeviceTimePoint P;
+			P.ap_data = RESTAPI_utils::to_object<APTimePoint>(C[0]);
+			P.ssid_data = RESTAPI_utils::to_object_array<SSIDTimePoint>(C[1]);
+			P.radio_data = RESTAPI_utils::to_object_array<RadioTimePoint>(C[2]);
+			P.device_info = RESTAPI_utils::to_object<DeviceInfo>(C[3]);
+			Json.bytes += C[0].size() + C[1].size() + C[2].size() + C[3].size();
+		}
+		Json.decodeNs = Since(Start);
+		Results.push_back(Json);
+
+		for (auto E : {Encoding::binary, Encoding::zlib}) {
+			BenchmarkResult Result{EncodingToString(E), Points.size()};
+			std::vector<std::string> Blobs(Points.size());
+			Start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < Points.size(); ++i)
+				Encode(Points[i], E, Blobs[i]);
+			Result.encodeNs = Since(Start);
+			Start = std::chrono::steady_clock::now();
+			for (const auto &Blob : Blobs) {
+				DeviceTimePoint P;
+				Decode((const unsigned char *)Blob.data(), Blob.size(), P);
+				Result.bytes += Blob.size();
+			}
+			Result.decodeNs = Since(Start);
+			for (const auto &P : Points)
+				if (!RoundTrip(P, E))
+					Result.mismatches++;
+			Results.push_back(Result);
+		}
+	}
+
+} // namespace OpenWifi::TimePointCodec
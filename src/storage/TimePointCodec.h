@@ -0,0 +1,61 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "Poco/JSON/Object.h"
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace OpenWifi::TimePointCodec {
+
+	//	How the timepoints table stores ap_data, ssid_data, radio_data and device_info:
+	//		json:	in their own TEXT columns, as before.
+	//		binary:	encoded together in the data BLOB column.
+	//		zlib:	as binary, compressed when that makes it smaller.
+	enum class Encoding { json, binary, zlib };
+
+	Encoding EncodingFromString(const std::string &E);
+	const char *EncodingToString(Encoding E);
+
+	//	The encoding used for the rows written from now on. Rows are always read in the encoding
+	//	they were written with.
+	void SetEncoding(Encoding E);
+	Encoding GetEncoding();
+
+	//	The blob holds the fields of the JSON columns, and the tidstats of each association that
+	//	JSON leaves out, in this layout:
+	//		version (1 byte), compression (1 byte), size of the fields (varint), the fields.
+	//	Unsigned integers are varints, signed ones zigzag varints, doubles varints of their
+	//	byte-swapped bits (so that 0 and round values stay short), and strings and arrays are
+	//	prefixed by their length. A new layout gets a new version: old ones stay decodable.
+	//
+	//	Version 2 added the tidstats of each association.
+	constexpr uint8_t Version = 2;
+
+	void Encode(const AnalyticsObjects::DeviceTimePoint &P, Encoding E, std::string &Blob);
+	//	False if the blob is truncated, corrupt, or of an unknown version.
+	bool Decode(const unsigned char *Blob, std::size_t Size, AnalyticsObjects::DeviceTimePoint &P);
+	//	True if P comes back from E with the same JSON and tidstats.
+	bool RoundTrip(const AnalyticsObjects::DeviceTimePoint &P, Encoding E);
+
+	//	Points, bytes and time spent converting rows, for each encoding.
+	enum Operation { json_encode, json_decode, binary_encode, binary_decode, operations };
+	void Count(Operation Op, uint64_t Bytes, std::chrono::steady_clock::time_point Start);
+	void CountFailure();
+	void GetStats(Poco::JSON::Object &Obj);
+
+	struct BenchmarkResult {
+		std::string encoding;
+		uint64_t points = 0, bytes = 0, encodeNs = 0, decodeNs = 0, mismatches = 0;
+	};
+
+	//	Encodes then decodes Points with every encoding, and counts the points that do not
+	//	survive the round trip.
+	void Benchmark(const std::vector<AnalyticsObjects::DeviceTimePoint> &Points,
+				   std::vector<BenchmarkResult> &Results);
+
+} // namespace OpenWifi::TimePointCodec
@@ -0,0 +1,110 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#include "storage_boardstats.h"
+#include "fmt/format.h"
+#include "framework/RESTAPI_utils.h"
+
+template <>
+void ORM::DB<OpenWifi::BoardStatsDBRecordType, OpenWifi::AnalyticsObjects::BoardStatsBucket>::
+	Convert(const OpenWifi::BoardStatsDBRecordType &In,
+			OpenWifi::AnalyticsObjects::BoardStatsBucket &Out);
+
+template <>
+void ORM::DB<OpenWifi::BoardStatsDBRecordType, OpenWifi::AnalyticsObjects::BoardStatsBucket>::
+	Convert(const OpenWifi::AnalyticsObjects::BoardStatsBucket &In,
+			OpenWifi::BoardStatsDBRecordType &Out);
+
+namespace OpenWifi {
+
+	static ORM::FieldVec BoardStats_Fields{// object info
+										   ORM::Field{"id", 64, true},
+										   ORM::Field{"boardId", ORM::FieldType::FT_TEXT},
+										   ORM::Field{"timestamp", ORM::FieldType::FT_BIGINT},
+										   ORM::Field{"points", ORM::FieldType::FT_BIGINT},
+										   ORM::Field{"stats", ORM::FieldType::FT_TEXT}};
+
+	static ORM::IndexVec BoardStatsDB_Indexes{
+		{std::string("boardstats_board_index"),
+		 ORM::IndexEntryVec{{std::string("boardId"), ORM::Indextype::ASC},
+							{std::string("timestamp"), ORM::Indextype::ASC}}}};
+
+	BoardStatsDB::BoardStatsDB(OpenWifi::DBType T, Poco::Data::SessionPool &P, Poco::Logger &L)
+		: DB(T, "boardstats", BoardStats_Fields, BoardStatsDB_Indexes, P, L, "bst") {}
+
+	bool BoardStatsDB::Upgrade([[maybe_unused]] uint32_t from, uint32_t &to) {
+		std::vector<std::string> Statements{};
+		RunScript(Statements);
+		to = 1;
+		return true;
+	}
+
+	static std::string BucketId(const std::string &boardId, uint64_t timestamp) {
+		return fmt::format("{}-{}", boardId, timestamp);
+	}
+
+	bool BoardStatsDB::Merge(const AnalyticsObjects::BoardStatsBucket &B) {
+		auto Id = BucketId(B.boardId, B.timestamp);
+		AnalyticsObjects::BoardStatsBucket Existing;
+		if (GetRecord("id", Id, Existing)) {
+			Existing.Merge(B);
+			return UpdateRecord("id", Id, Existing);
+		}
+		return CreateRecord(B);
+	}
+
+	static std::string TimeLine(const std::string &boardId, uint64_t FromDate, uint64_t LastDate) {
+		auto WhereClause = fmt::format(" boardId='{}' ", ORM::Escape(boardId));
+		if (FromDate)
+			WhereClause += fmt::format(" and (timestamp >= {}) ", FromDate);
+		if (LastDate)
+			WhereClause += fmt::format(" and (timestamp <= {}) ", LastDate);
+		return WhereClause;
+	}
+
+	bool BoardStatsDB::SelectRecords(const std::string &boardId, uint64_t FromDate,
+									 uint64_t LastDate, uint64_t MaxRecords, DB::RecordVec &Recs) {
+		return GetRecords(0, MaxRecords, Recs, TimeLine(boardId, FromDate, LastDate),
+						  " order by timestamp ASC ");
+	}
+
+	uint64_t BoardStatsDB::FirstBucket(const std::string &boardId) {
+		DB::RecordVec Recs;
+		if (!SelectRecords(boardId, 0, 0, 1, Recs) || Recs.empty())
+			return UINT64_MAX;
+		return Recs.front().timestamp;
+	}
+
+	bool BoardStatsDB::DeleteBoard(const std::string &boardId) {
+		return DeleteRecords(TimeLine(boardId, 0, 0));
+	}
+
+	bool BoardStatsDB::DeleteTimeLine(const std::string &boardId, uint64_t FromDate,
+									  uint64_t LastDate) {
+		return DeleteRecords(TimeLine(boardId, FromDate, LastDate));
+	}
+
+} // namespace OpenWifi
+
+template <>
+void ORM::DB<OpenWifi::BoardStatsDBRecordType, OpenWifi::AnalyticsObjects::BoardStatsBucket>::
+	Convert(const OpenWifi::BoardStatsDBRecordType &In,
+			OpenWifi::AnalyticsObjects::BoardStatsBucket &Out) {
+	Out = OpenWifi::RESTAPI_utils::to_object<OpenWifi::AnalyticsObjects::BoardStatsBucket>(
+		In.get<4>());
+	Out.boardId = In.get<1>();
+	Out.timestamp = In.get<2>();
+	Out.points = In.get<3>();
+}
+
+template <>
+void ORM::DB<OpenWifi::BoardStatsDBRecordType, OpenWifi::AnalyticsObjects::BoardStatsBucket>::
+	Convert(const OpenWifi::AnalyticsObjects::BoardStatsBucket &In,
+			OpenWifi::BoardStatsDBRecordType &Out) {
+	Out.set<0>(OpenWifi::BucketId(In.boardId, In.timestamp));
+	Out.set<1>(In.boardId);
+	Out.set<2>(In.timestamp);
+	Out.set<3>(In.points);
+	Out.set<4>(OpenWifi::RESTAPI_utils::to_string(In));
+}
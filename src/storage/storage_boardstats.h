@@ -0,0 +1,33 @@
+//
+// Created by stephane bourque on 2026-10-16.
+//
+
+#pragma once
+
+#include "RESTObjects/RESTAPI_AnalyticsObjects.h"
+#include "framework/orm.h"
+
+namespace OpenWifi {
+	typedef Poco::Tuple<std::string, std::string, uint64_t, uint64_t, std::string>
+		BoardStatsDBRecordType;
+
+	//	One row per board and time bucket, holding the accumulators of every time point the
+	//	board stored in that bucket.
+	class BoardStatsDB
+		: public ORM::DB<BoardStatsDBRecordType, AnalyticsObjects::BoardStatsBucket> {
+	  public:
+		BoardStatsDB(OpenWifi::DBType T, Poco::Data::SessionPool &P, Poco::Logger &L);
+		//	Adds the bucket to the stored one for the same board and timestamp, if any.
+		bool Merge(const AnalyticsObjects::BoardStatsBucket &B);
+		bool SelectRecords(const std::string &boardId, uint64_t FromDate, uint64_t LastDate,
+						   uint64_t MaxRecords, DB::RecordVec &Recs);
+		//	Start of the oldest stored bucket of the board, UINT64_MAX if there is none.
+		uint64_t FirstBucket(const std::string &boardId);
+		bool DeleteBoard(const std::string &boardId);
+		bool DeleteTimeLine(const std::string &boardId, uint64_t FromDate, uint64_t LastDate);
+		virtual ~BoardStatsDB(){};
+
+	  private:
+		bool Upgrade(uint32_t from, uint32_t &to) override;
+	};
+} // namespace OpenWifi
@@ -3,6 +3,7 @@
 //
 
 #include "storage_timepoints.h"
+#include "TimePointCodec.h"
 #include "fmt/format.h"
 #include "framework/OpenWifiTypes.h"
 #include "framework/RESTAPI_utils.h"
@@ -26,7 +27,8 @@ namespace OpenWifi {
 										  ORM::Field{"ssid_data", ORM::FieldType::FT_TEXT},
 										  ORM::Field{"radio_data", ORM::FieldType::FT_TEXT},
 										  ORM::Field{"device_info", ORM::FieldType::FT_TEXT},
-										  ORM::Field{"serialNumber", ORM::FieldType::FT_TEXT}};
+										  ORM::Field{"serialNumber", ORM::FieldType::FT_TEXT},
+										  ORM::Field{"data", ORM::FieldType::FT_BLOB}};
 
 	static ORM::IndexVec TimePointDB_Indexes{
 		{std::string("timepoint_board_index"),
@@ -40,12 +42,65 @@ namespace OpenWifi {
 		: DB(T, "timepoints", TimePoint_Fields, TimePointDB_Indexes, P, L, "tpo") {}
 
 	bool TimePointDB::Upgrade([[maybe_unused]] uint32_t from, uint32_t &to) {
-		std::vector<std::string> Statements{};
+		std::vector<std::string> Statements{"alter table " + TableName_ + " add column data " +
+											ORM::FieldTypeToChar(Type_, ORM::FieldType::FT_BLOB)};
 		RunScript(Statements);
 		to = 2;
 		return true;
 	}
 
+	bool TimePointDB::Migrate(uint64_t BatchSize, const std::atomic_bool &Stop,
+							  MigrationStats &Stats) {
+		auto Encoding = TimePointCodec::GetEncoding();
+		if (Encoding == TimePointCodec::Encoding::json) {
+			poco_warning(Logger_, "Time points are stored as JSON: there is nothing to migrate.");
+			return false;
+		}
+		const std::string Select =
+			fmt::format("select {} from {} where data is null or length(data)=0{}", SelectFields(),
+						TableName_, ComputeRange(0, BatchSize));
+		const std::string Update = ConvertParams(
+			"update " + TableName_ +
+			" set ap_data='', ssid_data='', radio_data='', device_info='', data=? where id=?");
+
+		std::vector<TimePointDBRecordType> Rows;
+		std::string Blob;
+		while (!Stop) {
+			Rows.clear();
+			if (!Join(Select, Rows))
+				return false;
+			if (Rows.empty())
+				return true;
+			uint64_t JsonBytes = 0, BinaryBytes = 0;
+			try {
+				Poco::Data::Session Session = Pool_.get();
+				Session.begin();
+				for (const auto &Row : Rows) {
+					AnalyticsObjects::DeviceTimePoint P;
+					Convert(Row, P);
+					TimePointCodec::Encode(P, Encoding, Blob);
+					Poco::Data::BLOB Data((const unsigned char *)Blob.data(), Blob.size());
+					auto id = Row.get<0>();
+					Poco::Data::Statement Statement(Session);
+					Statement << Update, Poco::Data::Keywords::use(Data),
+						Poco::Data::Keywords::use(id);
+					Statement.execute();
+					JsonBytes += Row.get<3>().size() + Row.get<4>().size() +
+								 Row.get<5>().size() + Row.get<6>().size();
+					BinaryBytes += Blob.size();
+				}
+				Session.commit();
+				Stats.rows += Rows.size();
+				Stats.jsonBytes += JsonBytes;
+				Stats.binaryBytes += BinaryBytes;
+			} catch (const Poco::Exception &E) {
+				Logger_.log(E);
+				return false;
+			}
+		}
+		return true;
+	}
+
 	bool TimePointDB::GetStats(const std::string &id, AnalyticsObjects::DeviceTimePointStats &S) {
 		S.count = S.firstPoint = S.lastPoint = 0;
 		auto F = [&](const DB::RecordName &R) -> bool {
@@ -113,6 +168,13 @@ namespace OpenWifi {
 		return true;
 	}
 
+	bool TimePointDB::HasPoints(const std::string &boardId, uint64_t FromDate, uint64_t LastDate) {
+		DB::RecordVec Recs;
+		return GetRecords(0, 1, Recs,
+						  fmt::format(" boardId='{}' and (timestamp >= {}) and (timestamp <= {}) ",
+									  ORM::Escape(boardId), FromDate, LastDate));
+	}
+
 	bool TimePointDB::GetRecordsPerDevice(const std::string &boardId, uint64_t FromDate, uint64_t LastDate,
 						uint64_t MaxRecords, std::vector<AnalyticsObjects::DeviceTimePoint> &Recs) {
 
@@ -193,6 +255,18 @@ void ORM::DB<OpenWifi::TimePointDBRecordType, OpenWifi::AnalyticsObjects::Device
 	Out.id = In.get<0>();
 	Out.boardId = In.get<1>();
 	Out.timestamp = In.get<2>();
+	Out.serialNumber = In.get<7>();
+	auto Start = std::chrono::steady_clock::now();
+	const auto &Data = In.get<8>();
+	if (!Data.isEmpty()) {
+		if (OpenWifi::TimePointCodec::Decode(Data.rawContent(), Data.size(), Out))
+			OpenWifi::TimePointCodec::Count(OpenWifi::TimePointCodec::binary_decode, Data.size(),
+											Start);
+		else
+			OpenWifi::TimePointCodec::CountFailure();
+		return;
+	}
+	//	Written before the data column, or with storage.timepoints.encoding = json.
 	Out.ap_data =
 		OpenWifi::RESTAPI_utils::to_object<OpenWifi::AnalyticsObjects::APTimePoint>(In.get<3>());
 	Out.ssid_data =
@@ -203,7 +277,10 @@ void ORM::DB<OpenWifi::TimePointDBRecordType, OpenWifi::AnalyticsObjects::Device
 			In.get<5>());
 	Out.device_info =
 		OpenWifi::RESTAPI_utils::to_object<OpenWifi::AnalyticsObjects::DeviceInfo>(In.get<6>());
-	Out.serialNumber = In.get<7>();
+	OpenWifi::TimePointCodec::Count(OpenWifi::TimePointCodec::json_decode,
+									In.get<3>().size() + In.get<4>().size() + In.get<5>().size() +
+										In.get<6>().size(),
+									Start);
 }
 
 template <>
@@ -212,9 +289,28 @@ void ORM::DB<OpenWifi::TimePointDBRecordType, OpenWifi::AnalyticsObjects::Device
 	Out.set<0>(In.id);
 	Out.set<1>(In.boardId);
 	Out.set<2>(In.timestamp);
+	Out.set<7>(In.serialNumber);
+	auto Start = std::chrono::steady_clock::now();
+	auto Encoding = OpenWifi::TimePointCodec::GetEncoding();
+	if (Encoding != OpenWifi::TimePointCodec::Encoding::json) {
+		std::string Blob;
+		OpenWifi::TimePointCodec::Encode(In, Encoding, Blob);
+		Out.set<3>("");
+		Out.set<4>("");
+		Out.set<5>("");
+		Out.set<6>("");
+		Out.set<8>(Poco::Data::BLOB((const unsigned char *)Blob.data(), Blob.size()));
+		OpenWifi::TimePointCodec::Count(OpenWifi::TimePointCodec::binary_encode, Blob.size(),
+										Start);
+		return;
+	}
 	Out.set<3>(OpenWifi::RESTAPI_utils::to_string(In.ap_data));
 	Out.set<4>(OpenWifi::RESTAPI_utils::to_string(In.ssid_data));
 	Out.set<5>(OpenWifi::RESTAPI_utils::to_string(In.radio_data));
 	Out.set<6>(OpenWifi::RESTAPI_utils::to_string(In.device_info));
-	Out.set<7>(In.serialNumber);
+	Out.set<8>(Poco::Data::BLOB());
+	OpenWifi::TimePointCodec::Count(OpenWifi::TimePointCodec::json_encode,
+									Out.get<3>().size() + Out.get<4>().size() +
+										Out.get<5>().size() + Out.get<6>().size(),
+									Start);
 }
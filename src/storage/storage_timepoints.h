@@ -4,13 +4,15 @@
 
 #pragma once
 
+#include "Poco/Data/LOB.h"
 #include "RESTObjects/RESTAPI_AnalyticsObjects.h"
 #include "framework/orm.h"
+#include <atomic>
 #include <set>
 
 namespace OpenWifi {
 	typedef Poco::Tuple<std::string, std::string, uint64_t, std::string, std::string, std::string,
-						std::string, std::string>
+						std::string, std::string, Poco::Data::BLOB>
 		TimePointDBRecordType;
 
 	class TimePointDB : public ORM::DB<TimePointDBRecordType, AnalyticsObjects::DeviceTimePoint> {
@@ -24,6 +26,15 @@ namespace OpenWifi {
 		bool GetRecordsPerDevice(const std::string &boardId, uint64_t FromDate, uint64_t LastDate,
 						   uint64_t MaxRecords, DB::RecordVec &Recs);
 		std::set<std::string> GetCurrentDeviceFromBoard(const std::string &boardId);
+		//	True if the board stored a time point in [FromDate, LastDate].
+		bool HasPoints(const std::string &boardId, uint64_t FromDate, uint64_t LastDate);
+
+		struct MigrationStats {
+			std::atomic_uint64_t rows = 0, jsonBytes = 0, binaryBytes = 0;
+		};
+		//	Rewrites the rows still stored as JSON in the current binary encoding, BatchSize rows
+		//	per transaction, until none is left or Stop is set.
+		bool Migrate(uint64_t BatchSize, const std::atomic_bool &Stop, MigrationStats &Stats);
 		virtual ~TimePointDB(){};
 
 	  private:
@@ -59,8 +59,8 @@ namespace OpenWifi {
 							{std::string("timestamp"), ORM::Indextype::ASC}}}};
 
 	WifiClientHistoryDB::WifiClientHistoryDB(OpenWifi::DBType T, Poco::Data::SessionPool &P,
-											 Poco::Logger &L)
-		: DB(T, "wificlienthistory", Boards_Fields, BoardsDB_Indexes, P, L, "wfh") {}
+											 Poco::Logger &L, const char *Table)
+		: DB(T, Table, Boards_Fields, BoardsDB_Indexes, P, L, "wfh") {}
 
 	bool WifiClientHistoryDB::Upgrade([[maybe_unused]] uint32_t from, uint32_t &to) {
 		std::vector<std::string> Statements{};
@@ -100,9 +100,9 @@ void ORM::DB<OpenWifi::WifiClientHistoryDBRecordType,
 	Convert(const OpenWifi::WifiClientHistoryDBRecordType &In,
 			OpenWifi::AnalyticsObjects::WifiClientHistory &Out) {
 	Out.timestamp = In.get<0>();
-	Out.station_id = In.get<1>();
-	Out.bssid = In.get<2>();
-	Out.ssid = In.get<3>();
+	Out.station_id = OpenWifi::MACAddress::FromString(In.get<1>());
+	Out.bssid = OpenWifi::MACAddress::FromString(In.get<2>());
+	Out.ssid = OpenWifi::SSIDName(In.get<3>());
 	Out.rssi = In.get<4>();
 	Out.rx_bitrate = In.get<5>();
 	Out.rx_chwidth = In.get<6>();
@@ -144,9 +144,9 @@ void ORM::DB<OpenWifi::WifiClientHistoryDBRecordType,
 	Convert(const OpenWifi::AnalyticsObjects::WifiClientHistory &In,
 			OpenWifi::WifiClientHistoryDBRecordType &Out) {
 	Out.set<0>(In.timestamp);
-	Out.set<1>(In.station_id);
-	Out.set<2>(In.bssid);
-	Out.set<3>(In.ssid);
+	Out.set<1>(In.station_id.ToHex());
+	Out.set<2>(In.bssid.ToHex());
+	Out.set<3>(In.ssid.str());
 	Out.set<4>(In.rssi);
 	Out.set<5>(In.rx_bitrate);
 	Out.set<6>(In.rx_chwidth);
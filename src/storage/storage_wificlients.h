@@ -50,7 +50,8 @@ namespace OpenWifi {
 	class WifiClientHistoryDB
 		: public ORM::DB<WifiClientHistoryDBRecordType, AnalyticsObjects::WifiClientHistory> {
 	  public:
-		WifiClientHistoryDB(OpenWifi::DBType T, Poco::Data::SessionPool &P, Poco::Logger &L);
+		WifiClientHistoryDB(OpenWifi::DBType T, Poco::Data::SessionPool &P, Poco::Logger &L,
+							const char *Table = "wificlienthistory");
 		virtual ~WifiClientHistoryDB(){};
 		bool GetClientMacs(std::vector<std::pair<std::string, std::string>> &Macs);
 